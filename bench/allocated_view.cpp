@@ -0,0 +1,88 @@
+/*
+ * Copyright 2021 Chandradeep Dey
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "bench.h"
+
+#include <allocated_view.h>
+#include <arena.h>
+#include <owned_view.h>
+
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace {
+constexpr std::size_t views = 4096;
+
+// creates views of T, moves each into a vector and drops them all, reported per view
+template <typename T> void run(const char *type) {
+    using owned = repeat_n::owned_view<T, 100>;
+    using heap = repeat_n::allocated_view<T, 100>;
+    using arena_view = repeat_n::allocated_view<T, 100, repeat_n::arena_allocator<T>>;
+    std::string name;
+
+    std::vector<owned> owned_views;
+    owned_views.reserve(views);
+    double embedded = bench::seconds_per_call([&] {
+        for (std::size_t i = 0; i < views; ++i) {
+            owned v{T{}};
+            owned_views.push_back(std::move(v));
+        }
+        bench::keep(owned_views.data());
+        owned_views.clear();
+    });
+    bench::report((name = std::string("owned_view ") + type).c_str(), views, sizeof(T), embedded);
+
+    std::vector<heap> heap_views;
+    heap_views.reserve(views);
+    double allocated = bench::seconds_per_call([&] {
+        for (std::size_t i = 0; i < views; ++i) {
+            heap v{T{}};
+            heap_views.push_back(std::move(v));
+        }
+        bench::keep(heap_views.data());
+        heap_views.clear();
+    });
+    bench::report((name = std::string("allocated_view std::allocator ") + type).c_str(), views, sizeof(T),
+                  allocated);
+
+    repeat_n::bump_arena arena;
+    repeat_n::arena_allocator<T> alloc(arena);
+    std::vector<arena_view> arena_views;
+    arena_views.reserve(views);
+    double bumped = bench::seconds_per_call([&] {
+        for (std::size_t i = 0; i < views; ++i) {
+            arena_view v(std::allocator_arg, alloc, T{});
+            arena_views.push_back(std::move(v));
+        }
+        bench::keep(arena_views.data());
+        arena_views.clear();
+        arena.reset();
+    });
+    bench::report((name = std::string("allocated_view arena_allocator ") + type).c_str(), views, sizeof(T), bumped);
+}
+} // namespace
+
+int main() {
+    bench::header();
+    run<std::array<double, 2>>("16 bytes");
+    run<std::array<double, 32>>("256 bytes");
+    run<std::array<double, 512>>("4096 bytes");
+    run<std::string>("std::string");
+}
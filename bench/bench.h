@@ -0,0 +1,73 @@
+/*
+ * Copyright 2021 Chandradeep Dey
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef REPEAT_N_VIEW_BENCH_H
+#define REPEAT_N_VIEW_BENCH_H
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+
+namespace bench {
+// keeps the optimizer from discarding work whose result is otherwise unused
+template <typename T> inline void keep(const T &value) {
+#if defined(__GNUC__)
+    asm volatile("" : : "r,m"(value) : "memory");
+#else
+    static volatile const T *sink;
+    sink = &value;
+#endif
+}
+
+inline void clobber() {
+#if defined(__GNUC__)
+    asm volatile("" : : : "memory");
+#endif
+}
+
+// best of a few repetitions, each sized to run for at least min_seconds
+template <typename F> double seconds_per_call(F &&f, double min_seconds = 0.05, int repetitions = 5) {
+    using clock = std::chrono::steady_clock;
+    f();
+    std::size_t calls = 1;
+    double best = 0;
+    for (int r = 0; r < repetitions; ++r) {
+        for (;;) {
+            auto start = clock::now();
+            for (std::size_t i = 0; i < calls; ++i) {
+                f();
+            }
+            double elapsed = std::chrono::duration<double>(clock::now() - start).count();
+            if (elapsed >= min_seconds) {
+                best = r == 0 ? elapsed / calls : std::min(best, elapsed / calls);
+                break;
+            }
+            calls *= 2;
+        }
+    }
+    return best;
+}
+
+inline void header() { std::printf("%-60s %12s %12s %14s\n", "benchmark", "elements", "ns/element", "MB/s"); }
+
+inline void report(const char *name, std::size_t elements, std::size_t element_size, double seconds) {
+    std::printf("%-60s %12zu %12.4f %14.1f\n", name, elements, seconds * 1e9 / elements,
+                elements * element_size / seconds / 1e6);
+}
+} // namespace bench
+
+#endif // REPEAT_N_VIEW_BENCH_H
@@ -0,0 +1,66 @@
+/*
+ * Copyright 2021 Chandradeep Dey
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "bench.h"
+
+#include <fill_into.h>
+#include <owned_view.h>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace {
+template <typename T> void run(const char *type, std::size_t n) {
+    repeat_n::owned_view<T, repeat_n::dynamic_extent> view(n, T(3));
+    std::vector<T> out(n);
+    std::string name;
+
+    double loop = bench::seconds_per_call([&] {
+        T *dest = out.data();
+        for (auto it = view.begin(); it != view.end(); ++it) {
+            *dest++ = *it;
+        }
+        bench::keep(out.data());
+        bench::clobber();
+    });
+    bench::report((name = std::string("iterator loop ") + type).c_str(), n, sizeof(T), loop);
+
+    double temporal = bench::seconds_per_call([&] {
+        repeat_n::fill_into(view, out.data(), repeat_n::store_mode::temporal);
+        bench::keep(out.data());
+        bench::clobber();
+    });
+    bench::report((name = std::string("fill_into temporal ") + type).c_str(), n, sizeof(T), temporal);
+
+    double streaming = bench::seconds_per_call([&] {
+        repeat_n::fill_into(view, out.data(), repeat_n::store_mode::non_temporal);
+        bench::keep(out.data());
+        bench::clobber();
+    });
+    bench::report((name = std::string("fill_into non_temporal ") + type).c_str(), n, sizeof(T), streaming);
+}
+} // namespace
+
+int main() {
+    bench::header();
+    for (std::size_t bytes : {std::size_t(64) << 10, std::size_t(4) << 20, std::size_t(64) << 20}) {
+        run<float>("float", bytes / sizeof(float));
+        run<double>("double", bytes / sizeof(double));
+        run<std::int32_t>("int32_t", bytes / sizeof(std::int32_t));
+        run<std::int64_t>("int64_t", bytes / sizeof(std::int64_t));
+    }
+}
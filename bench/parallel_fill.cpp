@@ -0,0 +1,59 @@
+/*
+ * Copyright 2021 Chandradeep Dey
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "bench.h"
+
+#include <owned_view.h>
+#include <parallel_fill.h>
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace {
+// fresh allocates the output on every call so that its pages are first touched by the fill, warm reuses one
+template <typename T> void run(const char *type, std::size_t n) {
+    repeat_n::owned_view<T, repeat_n::dynamic_extent> view(n, T(3));
+    std::unique_ptr<T[]> warm(new T[n]);
+    std::string name;
+
+    for (unsigned threads = 1; threads <= 64; threads *= 2) {
+        double fresh_seconds = bench::seconds_per_call([&] {
+            std::unique_ptr<T[]> fresh(new T[n]);
+            repeat_n::parallel_fill(view, fresh.get(), threads);
+            bench::keep(fresh.get());
+            bench::clobber();
+        });
+        name = std::string("parallel_fill fresh ") + type + " threads=" + std::to_string(threads);
+        bench::report(name.c_str(), n, sizeof(T), fresh_seconds);
+
+        double warm_seconds = bench::seconds_per_call([&] {
+            repeat_n::parallel_fill(view, warm.get(), threads);
+            bench::keep(warm.get());
+            bench::clobber();
+        });
+        name = std::string("parallel_fill warm ") + type + " threads=" + std::to_string(threads);
+        bench::report(name.c_str(), n, sizeof(T), warm_seconds);
+    }
+}
+} // namespace
+
+int main() {
+    bench::header();
+    const std::size_t bytes = std::size_t(256) << 20;
+    run<float>("float", bytes / sizeof(float));
+    run<std::int64_t>("int64_t", bytes / sizeof(std::int64_t));
+}
@@ -0,0 +1,185 @@
+/*
+ * Copyright 2021 Chandradeep Dey
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// Built twice, once against include/ and once against include-noexcept/, see CMakeLists.txt. The loops reading
+// elements clobber memory after every read, otherwise the compiler sees that a view's element never changes and
+// hoists the load out of the loop, which would leave nothing to measure.
+
+#include "bench.h"
+
+#include <foreign_view.h>
+#include <owned_view.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <string>
+#include <vector>
+
+namespace {
+template <std::size_t Size> struct blob {
+    unsigned char bytes[Size];
+};
+
+template <std::size_t Size> blob<Size> make_blob() {
+    blob<Size> b;
+    std::memset(b.bytes, 7, Size);
+    return b;
+}
+
+template <typename T> unsigned first_byte(const T &value) {
+    unsigned char byte;
+    std::memcpy(&byte, &value, 1);
+    return byte;
+}
+
+// a fixed permutation of [0, n) so random access cannot be predicted
+inline std::vector<std::ptrdiff_t> shuffled_indices(std::size_t n) {
+    std::vector<std::ptrdiff_t> indices(n);
+    std::uint32_t state = 2463534242u;
+    for (std::size_t i = 0; i < n; ++i) {
+        indices[i] = static_cast<std::ptrdiff_t>(i);
+    }
+    for (std::size_t i = n; i > 1; --i) {
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+        std::swap(indices[i - 1], indices[state % i]);
+    }
+    return indices;
+}
+
+template <typename T> struct fixture {
+    std::vector<T> out;
+    std::vector<std::ptrdiff_t> indices;
+    std::string label;
+    std::size_t n;
+};
+
+template <typename Range> void run_range(const char *kind, const Range &range, fixture<typename Range::value_type> &f) {
+    using T = typename Range::value_type;
+    const std::size_t n = f.n;
+    std::string name;
+
+    double iterate = bench::seconds_per_call([&] {
+        unsigned sum = 0;
+        for (auto it = range.begin(); it != range.end(); ++it) {
+            sum += first_byte(*it);
+            bench::clobber();
+        }
+        bench::keep(sum);
+    });
+    bench::report((name = std::string(kind) + " iterate " + f.label).c_str(), n, sizeof(T), iterate);
+
+    double reverse = bench::seconds_per_call([&] {
+        unsigned sum = 0;
+        for (auto it = range.rbegin(); it != range.rend(); ++it) {
+            sum += first_byte(*it);
+            bench::clobber();
+        }
+        bench::keep(sum);
+    });
+    bench::report((name = std::string(kind) + " reverse " + f.label).c_str(), n, sizeof(T), reverse);
+
+    double copy = bench::seconds_per_call([&] {
+        std::copy(range.begin(), range.end(), f.out.begin());
+        bench::keep(f.out.data());
+        bench::clobber();
+    });
+    bench::report((name = std::string(kind) + " copy " + f.label).c_str(), n, sizeof(T), copy);
+
+    double random = bench::seconds_per_call([&] {
+        unsigned sum = 0;
+        auto first = range.begin();
+        for (auto i : f.indices) {
+            sum += first_byte(*(first + i));
+            bench::clobber();
+        }
+        bench::keep(sum);
+    });
+    bench::report((name = std::string(kind) + " random access " + f.label).c_str(), n, sizeof(T), random);
+
+    // a single call, so the per element figure is really per call
+    double distance = bench::seconds_per_call([&] {
+        auto d = std::distance(range.begin(), range.end());
+        bench::keep(d);
+    });
+    bench::report((name = std::string(kind) + " distance " + f.label).c_str(), 1, sizeof(T), distance);
+}
+
+template <typename T> void run_raw(const T &value, fixture<T> &f) {
+    const std::size_t n = f.n;
+    std::string name;
+
+    double iterate = bench::seconds_per_call([&] {
+        unsigned sum = 0;
+        for (std::size_t i = 0; i < n; ++i) {
+            sum += first_byte(value);
+            bench::clobber();
+        }
+        bench::keep(sum);
+    });
+    bench::report((name = "raw loop iterate " + f.label).c_str(), n, sizeof(T), iterate);
+
+    double copy = bench::seconds_per_call([&] {
+        for (std::size_t i = 0; i < n; ++i) {
+            f.out[i] = value;
+        }
+        bench::keep(f.out.data());
+        bench::clobber();
+    });
+    bench::report((name = "raw loop copy " + f.label).c_str(), n, sizeof(T), copy);
+}
+
+template <typename T, std::size_t N> void run(const char *type, const T &value) {
+    fixture<T> f{std::vector<T>(N), shuffled_indices(N), std::string(type) + " N=" + std::to_string(N), N};
+
+    repeat_n::owned_view<T, N> owned(value);
+    run_range("owned_view", owned, f);
+
+    repeat_n::owned_view<T, repeat_n::dynamic_extent> owned_dynamic(N, value);
+    run_range("owned_view<dynamic_extent>", owned_dynamic, f);
+
+    repeat_n::foreign_view<T, N> foreign(&value);
+    run_range("foreign_view", foreign, f);
+
+    std::vector<T> materialized;
+    double fill = bench::seconds_per_call([&] {
+        materialized.clear();
+        std::fill_n(std::back_inserter(materialized), N, value);
+        bench::keep(materialized.data());
+    });
+    std::string name;
+    bench::report((name = "vector fill_n " + f.label).c_str(), N, sizeof(T), fill);
+    run_range("vector", materialized, f);
+
+    run_raw(value, f);
+}
+
+template <typename T> void run_sizes(const char *type, const T &value) {
+    run<T, std::size_t(1) << 10>(type, value);
+    run<T, std::size_t(1) << 16>(type, value);
+    run<T, std::size_t(1) << 20>(type, value);
+}
+} // namespace
+
+int main() {
+    bench::header();
+    run_sizes<char>("char", 'x');
+    run_sizes<std::uint64_t>("uint64_t", 42);
+    run_sizes<blob<64>>("blob<64>", make_blob<64>());
+}
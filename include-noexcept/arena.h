@@ -0,0 +1,23 @@
+/*
+ * Copyright 2021 Chandradeep Dey
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// include-noexcept/ is include/ with REPEAT_N_NO_EXCEPTIONS defined, which makes iterators into different views
+// assert instead of throw when they are compared
+#ifndef REPEAT_N_NO_EXCEPTIONS
+#define REPEAT_N_NO_EXCEPTIONS
+#endif
+
+#include "../include/arena.h"
@@ -0,0 +1,649 @@
+/*
+ * Copyright 2021 Chandradeep Dey
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef REPEAT_N_VIEW_ALGORITHM_H
+#define REPEAT_N_VIEW_ALGORITHM_H
+
+#include "foreign_view.h"
+#include "owned_view.h"
+
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+#include <type_traits>
+
+namespace repeat_n {
+template <typename It> struct is_repeat_iterator : std::false_type {};
+
+template <typename T, bool mutability, typename Check, typename Counter>
+struct is_repeat_iterator<owned_view_iterator<T, mutability, Check, Counter>> : std::true_type {};
+
+template <typename T, typename Check, typename Counter>
+struct is_repeat_iterator<foreign_view_iterator<T, Check, Counter>> : std::true_type {};
+
+template <typename It> struct is_repeat_iterator<std::reverse_iterator<It>> : is_repeat_iterator<It> {};
+
+namespace detail {
+template <typename OutputIt, typename Size, typename T> OutputIt fill_n(OutputIt out, Size n, const T &value) {
+    return std::fill_n(out, n, value);
+}
+
+// a single byte repeated is exactly what memset writes
+template <typename T, typename Size>
+typename std::enable_if<sizeof(T) == 1 && std::is_trivially_copyable<T>::value, T *>::type
+fill_n(T *out, Size n, const T &value) {
+    if (n <= 0) {
+        return out;
+    }
+    unsigned char byte;
+    std::memcpy(&byte, std::addressof(value), 1);
+    std::memset(out, byte, static_cast<std::size_t>(n));
+    return out + n;
+}
+
+template <typename It, typename OutputIt> OutputIt copy(It first, It last, OutputIt d_first) {
+    auto n = last - first;
+    return n > 0 ? detail::fill_n(d_first, n, *first) : d_first;
+}
+
+template <typename It, typename Size, typename OutputIt> OutputIt copy_n(It first, Size count, OutputIt result) {
+    return count > 0 ? detail::fill_n(result, count, *first) : result;
+}
+
+template <typename Container, typename It>
+typename Container::iterator insert(Container &c, typename Container::const_iterator pos, It first, It last,
+                                    std::true_type) {
+    using size_type = typename Container::size_type;
+    auto n = last - first;
+    return n > 0 ? c.insert(pos, static_cast<size_type>(n), *first) : c.insert(pos, first, first);
+}
+
+template <typename Container, typename It>
+typename Container::iterator insert(Container &c, typename Container::const_iterator pos, It first, It last,
+                                    std::false_type) {
+    return c.insert(pos, first, last);
+}
+
+template <typename Container, typename It> void assign(Container &c, It first, It last, std::true_type) {
+    using size_type = typename Container::size_type;
+    auto n = last - first;
+    if (n > 0) {
+        c.assign(static_cast<size_type>(n), *first);
+    } else {
+        c.clear();
+    }
+}
+
+template <typename Container, typename It> void assign(Container &c, It first, It last, std::false_type) {
+    c.assign(first, last);
+}
+
+// Every element of a view is the same object, so the algorithms below only look at the first element and the
+// length. All of them assume [first, last) comes from a single view.
+template <typename It, typename Pred> std::ptrdiff_t count_if(It first, It last, Pred pred) {
+    auto n = last - first;
+    return n > 0 && pred(*first) ? n : 0;
+}
+
+template <typename It, typename Pred> It find_if(It first, It last, Pred pred) {
+    return last - first > 0 && pred(*first) ? first : last;
+}
+
+template <typename It, typename BinaryPred> It adjacent_find(It first, It last, BinaryPred pred) {
+    return last - first > 1 && pred(*first, *first) ? first : last;
+}
+
+template <typename It> std::pair<It, It> minmax_element(It first, It last) {
+    // std::minmax_element reports the last of several equal largest elements
+    return last - first > 0 ? std::make_pair(first, last - 1) : std::make_pair(first, first);
+}
+
+// everything after the first element is removed only if the element equals itself, which a NaN does not
+template <typename It, typename BinaryPred> It unique(It first, It last, BinaryPred pred) {
+    return last - first > 1 && pred(*first, *first) ? first + 1 : last;
+}
+
+template <typename It1, typename It2, typename BinaryPred>
+bool equal(It1 first1, It1 last1, It2 first2, It2 last2, BinaryPred pred) {
+    auto n = last1 - first1;
+    return n == last2 - first2 && (n <= 0 || pred(*first1, *first2));
+}
+
+template <typename It, typename T, typename Compare> It lower_bound(It first, It last, const T &value, Compare comp) {
+    return last - first > 0 && comp(*first, value) ? last : first;
+}
+
+template <typename It, typename T, typename Compare> It upper_bound(It first, It last, const T &value, Compare comp) {
+    return last - first > 0 && !comp(value, *first) ? last : first;
+}
+
+template <typename It, typename T, typename Compare>
+bool binary_search(It first, It last, const T &value, Compare comp) {
+    return last - first > 0 && !comp(*first, value) && !comp(value, *first);
+}
+
+struct less {
+    template <typename T, typename U> bool operator()(const T &lhs, const U &rhs) const { return lhs < rhs; }
+};
+
+struct equal_to {
+    template <typename T, typename U> bool operator()(const T &lhs, const U &rhs) const { return lhs == rhs; }
+};
+
+template <typename T> struct equals_value {
+    template <typename U> bool operator()(const U &x) const { return x == value; }
+
+    const T &value;
+};
+
+template <typename Pred> struct negation {
+    template <typename U> bool operator()(const U &x) { return !pred(x); }
+
+    Pred pred;
+};
+} // namespace detail
+
+// These are found through ADL and are more specialized than their std:: counterparts, so a call made after
+// `using std::copy;` lowers to a fill instead of walking the view element by element.
+template <typename T, bool mutability, typename Check, typename Counter, typename OutputIt>
+OutputIt copy(owned_view_iterator<T, mutability, Check, Counter> first,
+              owned_view_iterator<T, mutability, Check, Counter> last, OutputIt d_first) {
+    return detail::copy(first, last, d_first);
+}
+
+template <typename T, typename Check, typename Counter, typename OutputIt>
+OutputIt copy(foreign_view_iterator<T, Check, Counter> first, foreign_view_iterator<T, Check, Counter> last,
+              OutputIt d_first) {
+    return detail::copy(first, last, d_first);
+}
+
+template <typename T, bool mutability, typename Check, typename Counter, typename OutputIt>
+OutputIt copy(std::reverse_iterator<owned_view_iterator<T, mutability, Check, Counter>> first,
+              std::reverse_iterator<owned_view_iterator<T, mutability, Check, Counter>> last, OutputIt d_first) {
+    return detail::copy(first, last, d_first);
+}
+
+template <typename T, typename Check, typename Counter, typename OutputIt>
+OutputIt copy(std::reverse_iterator<foreign_view_iterator<T, Check, Counter>> first,
+              std::reverse_iterator<foreign_view_iterator<T, Check, Counter>> last, OutputIt d_first) {
+    return detail::copy(first, last, d_first);
+}
+
+template <typename T, bool mutability, typename Check, typename Counter, typename Size, typename OutputIt>
+OutputIt copy_n(owned_view_iterator<T, mutability, Check, Counter> first, Size count, OutputIt result) {
+    return detail::copy_n(first, count, result);
+}
+
+template <typename T, typename Check, typename Counter, typename Size, typename OutputIt>
+OutputIt copy_n(foreign_view_iterator<T, Check, Counter> first, Size count, OutputIt result) {
+    return detail::copy_n(first, count, result);
+}
+
+template <typename T, bool mutability, typename Check, typename Counter, typename Size, typename OutputIt>
+OutputIt copy_n(std::reverse_iterator<owned_view_iterator<T, mutability, Check, Counter>> first, Size count,
+                OutputIt result) {
+    return detail::copy_n(first, count, result);
+}
+
+template <typename T, typename Check, typename Counter, typename Size, typename OutputIt>
+OutputIt copy_n(std::reverse_iterator<foreign_view_iterator<T, Check, Counter>> first, Size count, OutputIt result) {
+    return detail::copy_n(first, count, result);
+}
+// O(1) versions of the non-modifying algorithms, found through ADL the same way as copy. unique only reports where the
+// unique range ends, since everything after the first element already duplicates it, if the element equals itself.
+
+template <typename T, bool mutability, typename Check, typename Counter, typename Value>
+std::ptrdiff_t
+count(owned_view_iterator<T, mutability, Check, Counter> first, owned_view_iterator<T, mutability, Check, Counter> last,
+      const Value &value) {
+    return detail::count_if(first, last, detail::equals_value<Value>{value});
+}
+
+template <typename T, typename Check, typename Counter, typename Value>
+std::ptrdiff_t
+count(foreign_view_iterator<T, Check, Counter> first, foreign_view_iterator<T, Check, Counter> last,
+      const Value &value) {
+    return detail::count_if(first, last, detail::equals_value<Value>{value});
+}
+
+template <typename T, bool mutability, typename Check, typename Counter, typename UnaryPred>
+std::ptrdiff_t
+count_if(owned_view_iterator<T, mutability, Check, Counter> first,
+         owned_view_iterator<T, mutability, Check, Counter> last, UnaryPred pred) {
+    return detail::count_if(first, last, pred);
+}
+
+template <typename T, typename Check, typename Counter, typename UnaryPred>
+std::ptrdiff_t
+count_if(foreign_view_iterator<T, Check, Counter> first, foreign_view_iterator<T, Check, Counter> last,
+         UnaryPred pred) {
+    return detail::count_if(first, last, pred);
+}
+
+template <typename T, bool mutability, typename Check, typename Counter, typename Value>
+owned_view_iterator<T, mutability, Check, Counter>
+find(owned_view_iterator<T, mutability, Check, Counter> first, owned_view_iterator<T, mutability, Check, Counter> last,
+     const Value &value) {
+    return detail::find_if(first, last, detail::equals_value<Value>{value});
+}
+
+template <typename T, typename Check, typename Counter, typename Value>
+foreign_view_iterator<T, Check, Counter>
+find(foreign_view_iterator<T, Check, Counter> first, foreign_view_iterator<T, Check, Counter> last,
+     const Value &value) {
+    return detail::find_if(first, last, detail::equals_value<Value>{value});
+}
+
+template <typename T, bool mutability, typename Check, typename Counter, typename UnaryPred>
+owned_view_iterator<T, mutability, Check, Counter>
+find_if(owned_view_iterator<T, mutability, Check, Counter> first,
+        owned_view_iterator<T, mutability, Check, Counter> last, UnaryPred pred) {
+    return detail::find_if(first, last, pred);
+}
+
+template <typename T, typename Check, typename Counter, typename UnaryPred>
+foreign_view_iterator<T, Check, Counter>
+find_if(foreign_view_iterator<T, Check, Counter> first, foreign_view_iterator<T, Check, Counter> last, UnaryPred pred) {
+    return detail::find_if(first, last, pred);
+}
+
+template <typename T, bool mutability, typename Check, typename Counter, typename UnaryPred>
+owned_view_iterator<T, mutability, Check, Counter>
+find_if_not(owned_view_iterator<T, mutability, Check, Counter> first,
+            owned_view_iterator<T, mutability, Check, Counter> last, UnaryPred pred) {
+    return detail::find_if(first, last, detail::negation<UnaryPred>{pred});
+}
+
+template <typename T, typename Check, typename Counter, typename UnaryPred>
+foreign_view_iterator<T, Check, Counter>
+find_if_not(foreign_view_iterator<T, Check, Counter> first, foreign_view_iterator<T, Check, Counter> last,
+            UnaryPred pred) {
+    return detail::find_if(first, last, detail::negation<UnaryPred>{pred});
+}
+
+template <typename T, bool mutability, typename Check, typename Counter, typename UnaryPred>
+bool
+all_of(owned_view_iterator<T, mutability, Check, Counter> first,
+       owned_view_iterator<T, mutability, Check, Counter> last, UnaryPred pred) {
+    return detail::find_if(first, last, detail::negation<UnaryPred>{pred}) == last;
+}
+
+template <typename T, typename Check, typename Counter, typename UnaryPred>
+bool
+all_of(foreign_view_iterator<T, Check, Counter> first, foreign_view_iterator<T, Check, Counter> last, UnaryPred pred) {
+    return detail::find_if(first, last, detail::negation<UnaryPred>{pred}) == last;
+}
+
+template <typename T, bool mutability, typename Check, typename Counter, typename UnaryPred>
+bool
+any_of(owned_view_iterator<T, mutability, Check, Counter> first,
+       owned_view_iterator<T, mutability, Check, Counter> last, UnaryPred pred) {
+    return detail::find_if(first, last, pred) != last;
+}
+
+template <typename T, typename Check, typename Counter, typename UnaryPred>
+bool
+any_of(foreign_view_iterator<T, Check, Counter> first, foreign_view_iterator<T, Check, Counter> last, UnaryPred pred) {
+    return detail::find_if(first, last, pred) != last;
+}
+
+template <typename T, bool mutability, typename Check, typename Counter, typename UnaryPred>
+bool
+none_of(owned_view_iterator<T, mutability, Check, Counter> first,
+        owned_view_iterator<T, mutability, Check, Counter> last, UnaryPred pred) {
+    return detail::find_if(first, last, pred) == last;
+}
+
+template <typename T, typename Check, typename Counter, typename UnaryPred>
+bool
+none_of(foreign_view_iterator<T, Check, Counter> first, foreign_view_iterator<T, Check, Counter> last, UnaryPred pred) {
+    return detail::find_if(first, last, pred) == last;
+}
+
+template <typename T, bool mutability, typename Check, typename Counter>
+owned_view_iterator<T, mutability, Check, Counter>
+adjacent_find(owned_view_iterator<T, mutability, Check, Counter> first,
+              owned_view_iterator<T, mutability, Check, Counter> last) {
+    return detail::adjacent_find(first, last, detail::equal_to{});
+}
+
+template <typename T, typename Check, typename Counter>
+foreign_view_iterator<T, Check, Counter>
+adjacent_find(foreign_view_iterator<T, Check, Counter> first, foreign_view_iterator<T, Check, Counter> last) {
+    return detail::adjacent_find(first, last, detail::equal_to{});
+}
+
+template <typename T, bool mutability, typename Check, typename Counter, typename BinaryPred>
+owned_view_iterator<T, mutability, Check, Counter>
+adjacent_find(owned_view_iterator<T, mutability, Check, Counter> first,
+              owned_view_iterator<T, mutability, Check, Counter> last, BinaryPred pred) {
+    return detail::adjacent_find(first, last, pred);
+}
+
+template <typename T, typename Check, typename Counter, typename BinaryPred>
+foreign_view_iterator<T, Check, Counter>
+adjacent_find(foreign_view_iterator<T, Check, Counter> first, foreign_view_iterator<T, Check, Counter> last,
+              BinaryPred pred) {
+    return detail::adjacent_find(first, last, pred);
+}
+
+template <typename T, bool mutability, typename Check, typename Counter>
+owned_view_iterator<T, mutability, Check, Counter>
+min_element(owned_view_iterator<T, mutability, Check, Counter> first,
+            owned_view_iterator<T, mutability, Check, Counter>) {
+    return first;
+}
+
+template <typename T, typename Check, typename Counter>
+foreign_view_iterator<T, Check, Counter>
+min_element(foreign_view_iterator<T, Check, Counter> first, foreign_view_iterator<T, Check, Counter>) {
+    return first;
+}
+
+template <typename T, bool mutability, typename Check, typename Counter, typename Compare>
+owned_view_iterator<T, mutability, Check, Counter>
+min_element(owned_view_iterator<T, mutability, Check, Counter> first,
+            owned_view_iterator<T, mutability, Check, Counter>, Compare) {
+    return first;
+}
+
+template <typename T, typename Check, typename Counter, typename Compare>
+foreign_view_iterator<T, Check, Counter>
+min_element(foreign_view_iterator<T, Check, Counter> first, foreign_view_iterator<T, Check, Counter>, Compare) {
+    return first;
+}
+
+template <typename T, bool mutability, typename Check, typename Counter>
+owned_view_iterator<T, mutability, Check, Counter>
+max_element(owned_view_iterator<T, mutability, Check, Counter> first,
+            owned_view_iterator<T, mutability, Check, Counter>) {
+    return first;
+}
+
+template <typename T, typename Check, typename Counter>
+foreign_view_iterator<T, Check, Counter>
+max_element(foreign_view_iterator<T, Check, Counter> first, foreign_view_iterator<T, Check, Counter>) {
+    return first;
+}
+
+template <typename T, bool mutability, typename Check, typename Counter, typename Compare>
+owned_view_iterator<T, mutability, Check, Counter>
+max_element(owned_view_iterator<T, mutability, Check, Counter> first,
+            owned_view_iterator<T, mutability, Check, Counter>, Compare) {
+    return first;
+}
+
+template <typename T, typename Check, typename Counter, typename Compare>
+foreign_view_iterator<T, Check, Counter>
+max_element(foreign_view_iterator<T, Check, Counter> first, foreign_view_iterator<T, Check, Counter>, Compare) {
+    return first;
+}
+
+template <typename T, bool mutability, typename Check, typename Counter>
+std::pair<owned_view_iterator<T, mutability, Check, Counter>, owned_view_iterator<T, mutability, Check, Counter>>
+minmax_element(owned_view_iterator<T, mutability, Check, Counter> first,
+               owned_view_iterator<T, mutability, Check, Counter> last) {
+    return detail::minmax_element(first, last);
+}
+
+template <typename T, typename Check, typename Counter>
+std::pair<foreign_view_iterator<T, Check, Counter>, foreign_view_iterator<T, Check, Counter>>
+minmax_element(foreign_view_iterator<T, Check, Counter> first, foreign_view_iterator<T, Check, Counter> last) {
+    return detail::minmax_element(first, last);
+}
+
+template <typename T, bool mutability, typename Check, typename Counter, typename Compare>
+std::pair<owned_view_iterator<T, mutability, Check, Counter>, owned_view_iterator<T, mutability, Check, Counter>>
+minmax_element(owned_view_iterator<T, mutability, Check, Counter> first,
+               owned_view_iterator<T, mutability, Check, Counter> last, Compare) {
+    return detail::minmax_element(first, last);
+}
+
+template <typename T, typename Check, typename Counter, typename Compare>
+std::pair<foreign_view_iterator<T, Check, Counter>, foreign_view_iterator<T, Check, Counter>>
+minmax_element(foreign_view_iterator<T, Check, Counter> first, foreign_view_iterator<T, Check, Counter> last, Compare) {
+    return detail::minmax_element(first, last);
+}
+
+template <typename T, bool mutability, typename Check, typename Counter>
+bool is_sorted(owned_view_iterator<T, mutability, Check, Counter>, owned_view_iterator<T, mutability, Check, Counter>) {
+    return true;
+}
+
+template <typename T, typename Check, typename Counter>
+bool is_sorted(foreign_view_iterator<T, Check, Counter>, foreign_view_iterator<T, Check, Counter>) {
+    return true;
+}
+
+template <typename T, bool mutability, typename Check, typename Counter, typename Compare>
+bool
+is_sorted(owned_view_iterator<T, mutability, Check, Counter>, owned_view_iterator<T, mutability, Check, Counter>,
+          Compare) {
+    return true;
+}
+
+template <typename T, typename Check, typename Counter, typename Compare>
+bool is_sorted(foreign_view_iterator<T, Check, Counter>, foreign_view_iterator<T, Check, Counter>, Compare) {
+    return true;
+}
+
+template <typename T, bool mutability, typename Check, typename Counter>
+owned_view_iterator<T, mutability, Check, Counter>
+is_sorted_until(owned_view_iterator<T, mutability, Check, Counter>,
+                owned_view_iterator<T, mutability, Check, Counter> last) {
+    return last;
+}
+
+template <typename T, typename Check, typename Counter>
+foreign_view_iterator<T, Check, Counter>
+is_sorted_until(foreign_view_iterator<T, Check, Counter>, foreign_view_iterator<T, Check, Counter> last) {
+    return last;
+}
+
+template <typename T, bool mutability, typename Check, typename Counter, typename Compare>
+owned_view_iterator<T, mutability, Check, Counter>
+is_sorted_until(owned_view_iterator<T, mutability, Check, Counter>,
+                owned_view_iterator<T, mutability, Check, Counter> last, Compare) {
+    return last;
+}
+
+template <typename T, typename Check, typename Counter, typename Compare>
+foreign_view_iterator<T, Check, Counter>
+is_sorted_until(foreign_view_iterator<T, Check, Counter>, foreign_view_iterator<T, Check, Counter> last, Compare) {
+    return last;
+}
+
+template <typename T, bool mutability, typename Check, typename Counter>
+owned_view_iterator<T, mutability, Check, Counter>
+unique(owned_view_iterator<T, mutability, Check, Counter> first,
+       owned_view_iterator<T, mutability, Check, Counter> last) {
+    return detail::unique(first, last, detail::equal_to{});
+}
+
+template <typename T, typename Check, typename Counter>
+foreign_view_iterator<T, Check, Counter>
+unique(foreign_view_iterator<T, Check, Counter> first, foreign_view_iterator<T, Check, Counter> last) {
+    return detail::unique(first, last, detail::equal_to{});
+}
+
+template <typename T, bool mutability, typename Check, typename Counter, typename BinaryPred>
+owned_view_iterator<T, mutability, Check, Counter>
+unique(owned_view_iterator<T, mutability, Check, Counter> first,
+       owned_view_iterator<T, mutability, Check, Counter> last, BinaryPred pred) {
+    return detail::unique(first, last, pred);
+}
+
+template <typename T, typename Check, typename Counter, typename BinaryPred>
+foreign_view_iterator<T, Check, Counter>
+unique(foreign_view_iterator<T, Check, Counter> first, foreign_view_iterator<T, Check, Counter> last,
+       BinaryPred pred) {
+    return detail::unique(first, last, pred);
+}
+
+template <typename T, bool mutability, typename Check, typename Counter, typename Value>
+owned_view_iterator<T, mutability, Check, Counter>
+lower_bound(owned_view_iterator<T, mutability, Check, Counter> first,
+            owned_view_iterator<T, mutability, Check, Counter> last, const Value &value) {
+    return detail::lower_bound(first, last, value, detail::less{});
+}
+
+template <typename T, typename Check, typename Counter, typename Value>
+foreign_view_iterator<T, Check, Counter>
+lower_bound(foreign_view_iterator<T, Check, Counter> first, foreign_view_iterator<T, Check, Counter> last,
+            const Value &value) {
+    return detail::lower_bound(first, last, value, detail::less{});
+}
+
+template <typename T, bool mutability, typename Check, typename Counter, typename Value, typename Compare>
+owned_view_iterator<T, mutability, Check, Counter>
+lower_bound(owned_view_iterator<T, mutability, Check, Counter> first,
+            owned_view_iterator<T, mutability, Check, Counter> last, const Value &value, Compare comp) {
+    return detail::lower_bound(first, last, value, comp);
+}
+
+template <typename T, typename Check, typename Counter, typename Value, typename Compare>
+foreign_view_iterator<T, Check, Counter>
+lower_bound(foreign_view_iterator<T, Check, Counter> first, foreign_view_iterator<T, Check, Counter> last,
+            const Value &value, Compare comp) {
+    return detail::lower_bound(first, last, value, comp);
+}
+
+template <typename T, bool mutability, typename Check, typename Counter, typename Value>
+owned_view_iterator<T, mutability, Check, Counter>
+upper_bound(owned_view_iterator<T, mutability, Check, Counter> first,
+            owned_view_iterator<T, mutability, Check, Counter> last, const Value &value) {
+    return detail::upper_bound(first, last, value, detail::less{});
+}
+
+template <typename T, typename Check, typename Counter, typename Value>
+foreign_view_iterator<T, Check, Counter>
+upper_bound(foreign_view_iterator<T, Check, Counter> first, foreign_view_iterator<T, Check, Counter> last,
+            const Value &value) {
+    return detail::upper_bound(first, last, value, detail::less{});
+}
+
+template <typename T, bool mutability, typename Check, typename Counter, typename Value, typename Compare>
+owned_view_iterator<T, mutability, Check, Counter>
+upper_bound(owned_view_iterator<T, mutability, Check, Counter> first,
+            owned_view_iterator<T, mutability, Check, Counter> last, const Value &value, Compare comp) {
+    return detail::upper_bound(first, last, value, comp);
+}
+
+template <typename T, typename Check, typename Counter, typename Value, typename Compare>
+foreign_view_iterator<T, Check, Counter>
+upper_bound(foreign_view_iterator<T, Check, Counter> first, foreign_view_iterator<T, Check, Counter> last,
+            const Value &value, Compare comp) {
+    return detail::upper_bound(first, last, value, comp);
+}
+
+template <typename T, bool mutability, typename Check, typename Counter, typename Value>
+bool
+binary_search(owned_view_iterator<T, mutability, Check, Counter> first,
+              owned_view_iterator<T, mutability, Check, Counter> last, const Value &value) {
+    return detail::binary_search(first, last, value, detail::less{});
+}
+
+template <typename T, typename Check, typename Counter, typename Value>
+bool
+binary_search(foreign_view_iterator<T, Check, Counter> first, foreign_view_iterator<T, Check, Counter> last,
+              const Value &value) {
+    return detail::binary_search(first, last, value, detail::less{});
+}
+
+template <typename T, bool mutability, typename Check, typename Counter, typename Value, typename Compare>
+bool
+binary_search(owned_view_iterator<T, mutability, Check, Counter> first,
+              owned_view_iterator<T, mutability, Check, Counter> last, const Value &value, Compare comp) {
+    return detail::binary_search(first, last, value, comp);
+}
+
+template <typename T, typename Check, typename Counter, typename Value, typename Compare>
+bool
+binary_search(foreign_view_iterator<T, Check, Counter> first, foreign_view_iterator<T, Check, Counter> last,
+              const Value &value, Compare comp) {
+    return detail::binary_search(first, last, value, comp);
+}
+
+template <typename T, bool m1, typename C1, typename K1, typename U, bool m2, typename C2, typename K2>
+bool
+equal(owned_view_iterator<T, m1, C1, K1> first1, owned_view_iterator<T, m1, C1, K1> last1,
+      owned_view_iterator<U, m2, C2, K2> first2, owned_view_iterator<U, m2, C2, K2> last2) {
+    return detail::equal(first1, last1, first2, last2, detail::equal_to{});
+}
+
+template <typename T, bool m1, typename C1, typename K1, typename U, bool m2, typename C2, typename K2,
+          typename BinaryPred>
+bool
+equal(owned_view_iterator<T, m1, C1, K1> first1, owned_view_iterator<T, m1, C1, K1> last1,
+      owned_view_iterator<U, m2, C2, K2> first2, owned_view_iterator<U, m2, C2, K2> last2, BinaryPred pred) {
+    return detail::equal(first1, last1, first2, last2, pred);
+}
+
+template <typename T, bool m1, typename C1, typename K1, typename U, typename C2, typename K2>
+bool
+equal(owned_view_iterator<T, m1, C1, K1> first1, owned_view_iterator<T, m1, C1, K1> last1,
+      foreign_view_iterator<U, C2, K2> first2, foreign_view_iterator<U, C2, K2> last2) {
+    return detail::equal(first1, last1, first2, last2, detail::equal_to{});
+}
+
+template <typename T, bool m1, typename C1, typename K1, typename U, typename C2, typename K2, typename BinaryPred>
+bool
+equal(owned_view_iterator<T, m1, C1, K1> first1, owned_view_iterator<T, m1, C1, K1> last1,
+      foreign_view_iterator<U, C2, K2> first2, foreign_view_iterator<U, C2, K2> last2, BinaryPred pred) {
+    return detail::equal(first1, last1, first2, last2, pred);
+}
+
+template <typename T, typename C1, typename K1, typename U, bool m2, typename C2, typename K2>
+bool
+equal(foreign_view_iterator<T, C1, K1> first1, foreign_view_iterator<T, C1, K1> last1,
+      owned_view_iterator<U, m2, C2, K2> first2, owned_view_iterator<U, m2, C2, K2> last2) {
+    return detail::equal(first1, last1, first2, last2, detail::equal_to{});
+}
+
+template <typename T, typename C1, typename K1, typename U, bool m2, typename C2, typename K2, typename BinaryPred>
+bool
+equal(foreign_view_iterator<T, C1, K1> first1, foreign_view_iterator<T, C1, K1> last1,
+      owned_view_iterator<U, m2, C2, K2> first2, owned_view_iterator<U, m2, C2, K2> last2, BinaryPred pred) {
+    return detail::equal(first1, last1, first2, last2, pred);
+}
+
+template <typename T, typename C1, typename K1, typename U, typename C2, typename K2>
+bool
+equal(foreign_view_iterator<T, C1, K1> first1, foreign_view_iterator<T, C1, K1> last1,
+      foreign_view_iterator<U, C2, K2> first2, foreign_view_iterator<U, C2, K2> last2) {
+    return detail::equal(first1, last1, first2, last2, detail::equal_to{});
+}
+
+template <typename T, typename C1, typename K1, typename U, typename C2, typename K2, typename BinaryPred>
+bool
+equal(foreign_view_iterator<T, C1, K1> first1, foreign_view_iterator<T, C1, K1> last1,
+      foreign_view_iterator<U, C2, K2> first2, foreign_view_iterator<U, C2, K2> last2, BinaryPred pred) {
+    return detail::equal(first1, last1, first2, last2, pred);
+}
+
+// c.insert(pos, first, last), but a pair of view iterators becomes c.insert(pos, n, value)
+template <typename Container, typename It>
+typename Container::iterator insert(Container &c, typename Container::const_iterator pos, It first, It last) {
+    return detail::insert(c, pos, first, last, is_repeat_iterator<It>{});
+}
+
+// c.assign(first, last), but a pair of view iterators becomes c.assign(n, value)
+template <typename Container, typename It> void assign(Container &c, It first, It last) {
+    detail::assign(c, first, last, is_repeat_iterator<It>{});
+}
+} // namespace repeat_n
+
+#endif // REPEAT_N_VIEW_ALGORITHM_H
@@ -0,0 +1,256 @@
+/*
+ * Copyright 2021 Chandradeep Dey
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef REPEAT_N_VIEW_ALLOCATED_VIEW_H
+#define REPEAT_N_VIEW_ALLOCATED_VIEW_H
+
+#include "check.h"
+#include "extent.h"
+#include "foreign_view.h"
+#include "layout.h"
+#include "owned_view.h"
+#include "traits.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+namespace repeat_n {
+namespace detail {
+// false when the first argument would make the forwarding constructor take over copying, or allocator_arg_t
+template <typename Self, typename... Args> struct forwards_to_element : std::true_type {};
+
+template <typename Self, typename First, typename... Rest>
+struct forwards_to_element<Self, First, Rest...>
+    : std::integral_constant<bool, !std::is_same<typename std::decay<First>::type, Self>::value &&
+                                       !std::is_same<typename std::decay<First>::type, std::allocator_arg_t>::value> {};
+
+// std::allocator_traits<A>::is_always_equal, which only exists from C++17 on
+template <typename A, typename = void> struct allocator_always_equal : std::is_empty<A> {};
+
+template <typename A>
+struct allocator_always_equal<A, typename std::conditional<true, void, typename A::is_always_equal>::type>
+    : std::integral_constant<bool, A::is_always_equal::value> {};
+} // namespace detail
+
+// An owned_view whose element lives in memory from Allocator instead of inside the view, for example a bump_arena
+// through arena_allocator (see arena.h) or a std::pmr::polymorphic_allocator. Moving the view moves a pointer, and
+// iterators point at the element itself, so they stay valid when the view is moved. Copying allocates a new element;
+// copy assignment assigns to the existing one and so keeps its iterators valid too, unless the allocator propagates
+// on copy assignment and differs. Move assignment between allocators that neither propagate nor compare equal moves
+// the element into this view's own storage instead of taking over other's, like the standard containers do. A moved
+// from view may only be assigned to or destroyed. It uses the same iterators as owned_view, so everything that works
+// on those works here.
+template <typename T, std::size_t N = 1, typename Allocator = std::allocator<T>, typename Check = default_check,
+          typename Layout = plain>
+class allocated_view : private detail::extent<N> {
+    using traits = typename std::allocator_traits<Allocator>::template rebind_traits<T>;
+
+  public: // types
+    using value_type = T;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using reference = typename std::add_lvalue_reference<T>::type;
+    using const_reference = typename std::add_lvalue_reference<typename std::add_const<T>::type>::type;
+    using pointer = typename std::add_pointer<T>::type;
+    using const_pointer = typename std::add_pointer<typename std::add_const<T>::type>::type;
+    using iterator = owned_view_iterator<T, true, Check, detail::counter_t<N, Layout>>;
+    using const_iterator = owned_view_iterator<T, false, Check, detail::counter_t<N, Layout>>;
+    using reverse_iterator = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+    using subview_type = foreign_view<T, dynamic_extent, Check, Layout>;
+    using allocator_type = typename traits::allocator_type;
+
+  public: // constructors, the allocator_arg_t ones follow the convention of the standard library
+    template <typename... Args, std::size_t M = N,
+              typename std::enable_if<M != dynamic_extent &&
+                                          detail::forwards_to_element<allocated_view, Args...>::value,
+                                      bool>::type = true>
+    explicit allocated_view(Args &&...args) : M_contents(M_create(std::forward<Args>(args)...)) {}
+
+    template <typename... Args, std::size_t M = N, typename std::enable_if<M != dynamic_extent, bool>::type = true>
+    allocated_view(std::allocator_arg_t, const allocator_type &alloc, Args &&...args)
+        : M_alloc(alloc), M_contents(M_create(std::forward<Args>(args)...)) {}
+
+    // same argument order as the (size_type, value_type) constructors of the STL containers
+    template <typename... Args, std::size_t M = N, typename std::enable_if<M == dynamic_extent, bool>::type = true>
+    explicit allocated_view(size_type n, Args &&...args)
+        : detail::extent<N>(n), M_contents(M_create(std::forward<Args>(args)...)) {}
+
+    template <typename... Args, std::size_t M = N, typename std::enable_if<M == dynamic_extent, bool>::type = true>
+    allocated_view(std::allocator_arg_t, const allocator_type &alloc, size_type n, Args &&...args)
+        : detail::extent<N>(n), M_alloc(alloc), M_contents(M_create(std::forward<Args>(args)...)) {}
+
+    allocated_view(const allocated_view &other)
+        : detail::extent<N>(other), M_alloc(traits::select_on_container_copy_construction(other.M_alloc)),
+          M_contents(other.M_contents == nullptr ? nullptr : M_create(*other.M_contents)) {}
+
+    allocated_view(allocated_view &&other) noexcept
+        : detail::extent<N>(other), M_alloc(std::move(other.M_alloc)), M_contents(other.M_contents) {
+        other.M_contents = nullptr;
+    }
+
+    allocated_view &operator=(const allocated_view &other) {
+        if (this != &other) {
+            M_copy_assign(other, typename traits::propagate_on_container_copy_assignment{});
+            static_cast<detail::extent<N> &>(*this) = other;
+        }
+        return *this;
+    }
+
+    allocated_view &operator=(allocated_view &&other) noexcept(steals_on_move::value) {
+        if (this != &other) {
+            M_move_assign(other, steals_on_move{});
+            static_cast<detail::extent<N> &>(*this) = other;
+        }
+        return *this;
+    }
+
+    ~allocated_view() { M_destroy(); }
+
+    allocator_type get_allocator() const { return M_alloc; }
+
+  public: // access contents directly
+    reference data() noexcept { return *M_contents; }
+
+    const_reference data() const noexcept { return *M_contents; }
+
+  public: // iterators
+    iterator begin() noexcept { return iterator(M_contents, 0); }
+
+    const_iterator begin() const noexcept { return const_iterator(M_contents, 0); }
+
+    const_iterator cbegin() const noexcept { return const_iterator(M_contents, 0); }
+
+    iterator end() noexcept { return iterator(M_contents, size()); }
+
+    const_iterator end() const noexcept { return const_iterator(M_contents, size()); }
+
+    const_iterator cend() const noexcept { return const_iterator(M_contents, size()); }
+
+    reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+
+    const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(end()); }
+
+    const_reverse_iterator crbegin() const noexcept { return const_reverse_iterator(cend()); }
+
+    reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
+
+    const_reverse_iterator rend() const noexcept { return const_reverse_iterator(begin()); }
+
+    const_reverse_iterator crend() const noexcept { return const_reverse_iterator(cbegin()); }
+
+  public: // capacity
+    size_type size() const noexcept { return this->M_extent(); }
+
+    difference_type max_size() const noexcept { return std::numeric_limits<difference_type>::max(); }
+
+  public: // sub-ranges in O(1), foreign views of this view's element that stay valid until it is destroyed
+    // like std::basic_string_view::substr, count is clamped to what is left after pos
+    subview_type subview(size_type pos, size_type count = dynamic_extent) const noexcept {
+        return subview_type(std::min(count, size() - std::min(pos, size())), M_contents);
+    }
+
+    // the first half gets the smaller share of an odd size
+    std::pair<subview_type, subview_type> split() const noexcept {
+        return std::make_pair(subview(0, size() / 2), subview(size() / 2));
+    }
+
+  private:
+    template <typename... Args> pointer M_create(Args &&...args) {
+        pointer p = traits::allocate(M_alloc, 1);
+#ifndef REPEAT_N_NO_EXCEPTIONS
+        try {
+            traits::construct(M_alloc, p, std::forward<Args>(args)...);
+        } catch (...) {
+            traits::deallocate(M_alloc, p, 1);
+            throw;
+        }
+#else
+        traits::construct(M_alloc, p, std::forward<Args>(args)...);
+#endif
+        return p;
+    }
+
+    void M_destroy() noexcept {
+        if (M_contents != nullptr) {
+            traits::destroy(M_alloc, M_contents);
+            traits::deallocate(M_alloc, M_contents, 1);
+            M_contents = nullptr;
+        }
+    }
+
+    // other's element, or none, copied or moved as Element into this view's, which is allocated from M_alloc if needed
+    template <typename Element> void M_assign_element(pointer element) {
+        if (element == nullptr) {
+            M_destroy();
+        } else if (M_contents == nullptr) {
+            M_contents = M_create(static_cast<Element>(*element));
+        } else {
+            *M_contents = static_cast<Element>(*element);
+        }
+    }
+
+    // the current element has to go back to the allocator it came from before a different one replaces it
+    void M_copy_assign(const allocated_view &other, std::true_type) {
+        if (M_alloc != other.M_alloc) {
+            M_destroy();
+        }
+        M_alloc = other.M_alloc;
+        M_assign_element<const T &>(other.M_contents);
+    }
+
+    void M_copy_assign(const allocated_view &other, std::false_type) {
+        M_assign_element<const T &>(other.M_contents);
+    }
+
+    // whether move assignment can always take over other's element, which otherwise depends on comparing allocators
+    using steals_on_move =
+        std::integral_constant<bool, traits::propagate_on_container_move_assignment::value ||
+                                         detail::allocator_always_equal<allocator_type>::value>;
+
+    void M_move_assign(allocated_view &other, std::true_type) noexcept {
+        M_destroy();
+        M_move_allocator(other, typename traits::propagate_on_container_move_assignment{});
+        M_contents = other.M_contents;
+        other.M_contents = nullptr;
+    }
+
+    void M_move_assign(allocated_view &other, std::false_type) {
+        if (M_alloc == other.M_alloc) {
+            M_move_assign(other, std::true_type{});
+        } else {
+            M_assign_element<T &&>(other.M_contents);
+        }
+    }
+
+    void M_move_allocator(allocated_view &other, std::true_type) noexcept { M_alloc = std::move(other.M_alloc); }
+
+    void M_move_allocator(allocated_view &, std::false_type) noexcept {}
+
+    allocator_type M_alloc;
+    pointer M_contents;
+};
+
+template <typename T, std::size_t N, typename Allocator, typename Check, typename Layout>
+struct is_repeat_view<allocated_view<T, N, Allocator, Check, Layout>> : std::true_type {};
+} // namespace repeat_n
+
+#endif // REPEAT_N_VIEW_ALLOCATED_VIEW_H
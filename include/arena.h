@@ -0,0 +1,129 @@
+/*
+ * Copyright 2021 Chandradeep Dey
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef REPEAT_N_VIEW_ARENA_H
+#define REPEAT_N_VIEW_ARENA_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+
+namespace repeat_n {
+// Hands out memory by bumping a pointer through blocks of at least block_size bytes. deallocate does nothing, all of
+// it comes back at once on reset() or destruction, so allocating is a few instructions and freeing is free. Not
+// thread safe.
+class bump_arena {
+  public:
+    explicit bump_arena(std::size_t block_size = std::size_t(64) << 10) noexcept : M_block_size(block_size) {}
+
+    bump_arena(const bump_arena &) = delete;
+
+    bump_arena &operator=(const bump_arena &) = delete;
+
+    ~bump_arena() { M_release(nullptr); }
+
+    // alignment has to be a power of two
+    void *allocate(std::size_t bytes, std::size_t alignment) {
+        std::uintptr_t start = (M_next + alignment - 1) & ~(std::uintptr_t(alignment) - 1);
+        if (M_blocks == nullptr || start + bytes > M_end) {
+            M_grow(bytes + alignment);
+            start = (M_next + alignment - 1) & ~(std::uintptr_t(alignment) - 1);
+        }
+        M_next = start + bytes;
+        return reinterpret_cast<void *>(start);
+    }
+
+    void deallocate(void *, std::size_t) noexcept {}
+
+    // Frees every block but the most recent one and starts handing that one out again. Everything allocated so far
+    // must be dead by now.
+    void reset() noexcept {
+        if (M_blocks != nullptr) {
+            M_release(M_blocks);
+            M_blocks->next = nullptr;
+            M_next = reinterpret_cast<std::uintptr_t>(M_blocks + 1);
+        }
+    }
+
+  private:
+    struct block {
+        block *next;
+        std::size_t size;
+    };
+
+    void M_grow(std::size_t at_least) {
+        const std::size_t size = sizeof(block) + std::max(M_block_size, at_least);
+        block *fresh = static_cast<block *>(::operator new(size));
+        fresh->next = M_blocks;
+        fresh->size = size;
+        M_blocks = fresh;
+        M_next = reinterpret_cast<std::uintptr_t>(fresh + 1);
+        M_end = reinterpret_cast<std::uintptr_t>(fresh) + size;
+    }
+
+    // frees the blocks after keep, or all of them when keep is null
+    void M_release(block *keep) noexcept {
+        block *b = keep == nullptr ? M_blocks : keep->next;
+        while (b != nullptr) {
+            block *next = b->next;
+            ::operator delete(b);
+            b = next;
+        }
+        if (keep != nullptr) {
+            M_end = reinterpret_cast<std::uintptr_t>(keep) + keep->size;
+        }
+    }
+
+    std::size_t M_block_size;
+    block *M_blocks = nullptr;
+    std::uintptr_t M_next = 0;
+    std::uintptr_t M_end = 0;
+};
+
+// A standard allocator drawing from a bump_arena, for allocated_view or any container. Copies share the arena.
+template <typename T> class arena_allocator {
+  public:
+    using value_type = T;
+    using propagate_on_container_copy_assignment = std::true_type;
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_swap = std::true_type;
+
+    explicit arena_allocator(bump_arena &arena) noexcept : M_arena(&arena) {}
+
+    template <typename U> arena_allocator(const arena_allocator<U> &other) noexcept : M_arena(&other.arena()) {}
+
+    T *allocate(std::size_t n) { return static_cast<T *>(M_arena->allocate(n * sizeof(T), alignof(T))); }
+
+    void deallocate(T *p, std::size_t n) noexcept { M_arena->deallocate(p, n * sizeof(T)); }
+
+    bump_arena &arena() const noexcept { return *M_arena; }
+
+    template <typename U> friend bool operator==(const arena_allocator &lhs, const arena_allocator<U> &rhs) noexcept {
+        return &lhs.arena() == &rhs.arena();
+    }
+
+    template <typename U> friend bool operator!=(const arena_allocator &lhs, const arena_allocator<U> &rhs) noexcept {
+        return !(lhs == rhs);
+    }
+
+  private:
+    bump_arena *M_arena;
+};
+} // namespace repeat_n
+
+#endif // REPEAT_N_VIEW_ARENA_H
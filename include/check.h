@@ -0,0 +1,68 @@
+/*
+ * Copyright 2021 Chandradeep Dey
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef REPEAT_N_VIEW_CHECK_H
+#define REPEAT_N_VIEW_CHECK_H
+
+#include "config.h"
+
+#include <cassert>
+
+// the headers in include-noexcept/ define this before including the ones here
+#if !defined(REPEAT_N_NO_EXCEPTIONS) && defined(__GNUC__) && !defined(__EXCEPTIONS)
+#define REPEAT_N_NO_EXCEPTIONS
+#endif
+
+#ifndef REPEAT_N_NO_EXCEPTIONS
+#include <stdexcept>
+#endif
+
+namespace repeat_n {
+// What iterators do when asked to compare or subtract iterators into different views. Only the counters are ever
+// compared, so with unchecked a loop over a view compiles to the same code as a counted loop.
+struct unchecked {
+    static REPEAT_N_CONSTEXPR14 void same_view(const void *, const void *, const char *) noexcept {}
+};
+
+// unchecked once NDEBUG is defined
+struct assert_checked {
+    static REPEAT_N_CONSTEXPR14 void same_view(const void *lhs, const void *rhs, const char *what) noexcept {
+        assert(lhs == rhs && what);
+        (void)lhs, (void)rhs, (void)what;
+    }
+};
+
+#ifndef REPEAT_N_NO_EXCEPTIONS
+struct throw_checked {
+    static REPEAT_N_CONSTEXPR14 void same_view(const void *lhs, const void *rhs, const char *what) {
+        if (lhs != rhs) {
+            throw std::invalid_argument(what);
+        }
+    }
+};
+#endif
+
+// define REPEAT_N_DEFAULT_CHECK to one of the above to change the policy views get when none is given
+#ifdef REPEAT_N_DEFAULT_CHECK
+using default_check = REPEAT_N_DEFAULT_CHECK;
+#elif defined(REPEAT_N_NO_EXCEPTIONS)
+using default_check = assert_checked;
+#else
+using default_check = throw_checked;
+#endif
+} // namespace repeat_n
+
+#endif // REPEAT_N_VIEW_CHECK_H
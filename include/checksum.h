@@ -0,0 +1,202 @@
+/*
+ * Copyright 2021 Chandradeep Dey
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef REPEAT_N_VIEW_CHECKSUM_H
+#define REPEAT_N_VIEW_CHECKSUM_H
+
+#include "fold.h"
+#include "foreign_view.h"
+#include "owned_view.h"
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace repeat_n {
+// the base polynomial_hash uses unless it is given one. Any base is taken modulo 2^61 - 1, and has to leave neither 0
+// nor 1, which would hash only the last byte or just sum the bytes.
+constexpr std::uint64_t default_polynomial_base = 0x16a09e667f3bcc9;
+
+namespace detail {
+// reflected CRC-32 polynomial, the one of zlib, PNG and Ethernet
+constexpr std::uint32_t crc32_polynomial = 0xedb88320;
+
+// a * b modulo the CRC polynomial, with x^0 in the top bit as in the reflected CRC register
+inline std::uint32_t crc32_multiply(std::uint32_t a, std::uint32_t b) noexcept {
+    std::uint32_t product = 0;
+    for (std::uint32_t m = std::uint32_t(1) << 31; m != 0; m >>= 1) {
+        if (a & m) {
+            product ^= b;
+        }
+        b = b & 1 ? (b >> 1) ^ crc32_polynomial : b >> 1;
+    }
+    return product;
+}
+
+// A run of bytes as its CRC and x^(8 * length) modulo the polynomial. Appending the run b to the run a shifts the
+// CRC of a past the length of b, which is all zlib's crc32_combine does, so concatenation is associative and fold can
+// square its way to N copies.
+struct crc32_segment {
+    std::uint32_t crc;
+    std::uint32_t shift;
+};
+
+struct crc32_concat {
+    crc32_segment operator()(const crc32_segment &a, const crc32_segment &b) const noexcept {
+        return crc32_segment{crc32_multiply(b.shift, a.crc) ^ b.crc, crc32_multiply(a.shift, b.shift)};
+    }
+};
+
+struct crc32_shift_concat {
+    std::uint32_t operator()(std::uint32_t a, std::uint32_t b) const noexcept { return crc32_multiply(a, b); }
+};
+
+constexpr std::uint32_t crc32_x0 = std::uint32_t(1) << 31;
+constexpr std::uint32_t crc32_x8 = std::uint32_t(1) << 23;
+
+inline crc32_segment crc32_of(const unsigned char *bytes, std::size_t length) noexcept {
+    std::uint32_t crc = 0xffffffff;
+    for (std::size_t i = 0; i < length; ++i) {
+        crc ^= bytes[i];
+        for (int bit = 0; bit < 8; ++bit) {
+            crc = crc & 1 ? (crc >> 1) ^ crc32_polynomial : crc >> 1;
+        }
+    }
+    crc32_shift_concat op;
+    return crc32_segment{~crc, detail::fold(crc32_x8, length, op, crc32_x0, fold_tag<fold_kind::squaring>{})};
+}
+
+constexpr std::uint64_t mersenne61 = (std::uint64_t(1) << 61) - 1;
+
+#if defined(__SIZEOF_INT128__)
+// __extension__ keeps -Wpedantic quiet about a type ISO C++ does not have
+__extension__ typedef unsigned __int128 uint128;
+#endif
+
+// a * b mod 2^61 - 1, for a and b below it
+inline std::uint64_t multiply_mod61(std::uint64_t a, std::uint64_t b) noexcept {
+#if defined(__SIZEOF_INT128__)
+    const uint128 product = static_cast<uint128>(a) * b;
+    std::uint64_t r = (static_cast<std::uint64_t>(product) & mersenne61) + static_cast<std::uint64_t>(product >> 61);
+#else
+    // with 2^64 = 8 and 2^61 = 1 modulo 2^61 - 1
+    const std::uint64_t hi = (a >> 32) * (b >> 32);
+    const std::uint64_t mid = (a >> 32) * (b & 0xffffffff) + (a & 0xffffffff) * (b >> 32);
+    const std::uint64_t lo = (a & 0xffffffff) * (b & 0xffffffff);
+    std::uint64_t r = (hi << 3) + (mid >> 29) + ((mid & ((std::uint64_t(1) << 29) - 1)) << 32) + (lo >> 61) +
+                      (lo & mersenne61);
+#endif
+    r = (r & mersenne61) + (r >> 61);
+    return r >= mersenne61 ? r - mersenne61 : r;
+}
+
+inline std::uint64_t add_mod61(std::uint64_t a, std::uint64_t b) noexcept {
+    const std::uint64_t sum = a + b;
+    return sum >= mersenne61 ? sum - mersenne61 : sum;
+}
+
+// a run of bytes as its hash and base^length, concatenated the same way as crc32_segment
+struct polynomial_segment {
+    std::uint64_t hash;
+    std::uint64_t shift;
+};
+
+struct polynomial_concat {
+    polynomial_segment operator()(const polynomial_segment &a, const polynomial_segment &b) const noexcept {
+        return polynomial_segment{add_mod61(multiply_mod61(a.hash, b.shift), b.hash), multiply_mod61(a.shift, b.shift)};
+    }
+};
+
+struct polynomial_shift_concat {
+    std::uint64_t operator()(std::uint64_t a, std::uint64_t b) const noexcept { return multiply_mod61(a, b); }
+};
+
+// every polynomial_hash goes through here, so this is where base is brought below 2^61 - 1 for multiply_mod61
+inline polynomial_segment polynomial_of(const unsigned char *bytes, std::size_t length, std::uint64_t base) noexcept {
+    base %= mersenne61;
+    assert(base > 1 && "polynomial_hash needs a base other than 0 and 1 modulo 2^61 - 1");
+    std::uint64_t hash = 0;
+    for (std::size_t i = 0; i < length; ++i) {
+        hash = add_mod61(multiply_mod61(hash, base), std::uint64_t(bytes[i]) + 1);
+    }
+    polynomial_shift_concat op;
+    return polynomial_segment{hash, detail::fold(base, length, op, std::uint64_t(1), fold_tag<fold_kind::squaring>{})};
+}
+
+template <typename T> std::uint32_t crc32_repeated(const T &value, std::size_t n, std::uint32_t crc) noexcept {
+    static_assert(std::is_trivially_copyable<T>::value, "crc32 reads the object representation of T");
+    crc32_concat op;
+    const crc32_segment init{crc, crc32_x0};
+    const crc32_segment element = crc32_of(reinterpret_cast<const unsigned char *>(&value), sizeof(T));
+    return n == 0 ? crc : detail::fold(element, n, op, init, fold_tag<fold_kind::squaring>{}).crc;
+}
+
+template <typename T>
+std::uint64_t polynomial_hash_repeated(const T &value, std::size_t n, std::uint64_t seed, std::uint64_t base) noexcept {
+    static_assert(std::is_trivially_copyable<T>::value, "polynomial_hash reads the object representation of T");
+    polynomial_concat op;
+    const polynomial_segment init{seed % mersenne61, 1};
+    const polynomial_segment element = polynomial_of(reinterpret_cast<const unsigned char *>(&value), sizeof(T), base);
+    return n == 0 ? init.hash : detail::fold(element, n, op, init, fold_tag<fold_kind::squaring>{}).hash;
+}
+} // namespace detail
+
+// The standard CRC-32, the same as zlib's crc32(crc, data, length): pass the CRC of what came before to continue it.
+inline std::uint32_t crc32(const void *data, std::size_t length, std::uint32_t crc = 0) noexcept {
+    const detail::crc32_segment next = detail::crc32_of(static_cast<const unsigned char *>(data), length);
+    return detail::crc32_concat{}(detail::crc32_segment{crc, detail::crc32_x0}, next).crc;
+}
+
+// The CRC-32 of the object representations of the view's elements one after another, which is the CRC-32 of the
+// materialized buffer, in O(sizeof(T) + log N). The element's own CRC is shifted and combined with itself by squaring,
+// as in fold.h, instead of running over every byte.
+template <typename T, std::size_t N, typename Check, typename Layout>
+std::uint32_t crc32(const owned_view<T, N, Check, Layout> &view, std::uint32_t crc = 0) noexcept {
+    return detail::crc32_repeated(view.data(), view.size(), crc);
+}
+
+template <typename T, std::size_t N, typename Check, typename Layout>
+std::uint32_t crc32(const foreign_view<T, N, Check, Layout> &view, std::uint32_t crc = 0) noexcept {
+    return view.size() == 0 ? crc : detail::crc32_repeated(*view.begin(), view.size(), crc);
+}
+
+// The rolling hash h = h * base + byte + 1 modulo 2^61 - 1 over each byte, starting from seed. Adding one keeps runs
+// of zero bytes, padding included, from all hashing to the seed. As with crc32, seed can be the hash of what came
+// before.
+inline std::uint64_t polynomial_hash(const void *data, std::size_t length, std::uint64_t seed = 0,
+                                     std::uint64_t base = default_polynomial_base) noexcept {
+    const detail::polynomial_segment next =
+        detail::polynomial_of(static_cast<const unsigned char *>(data), length, base);
+    return detail::polynomial_concat{}(detail::polynomial_segment{seed % detail::mersenne61, 1}, next).hash;
+}
+
+// the polynomial_hash of the materialized buffer in O(sizeof(T) + log N), by squaring like crc32
+template <typename T, std::size_t N, typename Check, typename Layout>
+std::uint64_t polynomial_hash(const owned_view<T, N, Check, Layout> &view, std::uint64_t seed = 0,
+                              std::uint64_t base = default_polynomial_base) noexcept {
+    return detail::polynomial_hash_repeated(view.data(), view.size(), seed, base);
+}
+
+template <typename T, std::size_t N, typename Check, typename Layout>
+std::uint64_t polynomial_hash(const foreign_view<T, N, Check, Layout> &view, std::uint64_t seed = 0,
+                              std::uint64_t base = default_polynomial_base) noexcept {
+    return view.size() == 0 ? seed % detail::mersenne61
+                            : detail::polynomial_hash_repeated(*view.begin(), view.size(), seed, base);
+}
+} // namespace repeat_n
+
+#endif // REPEAT_N_VIEW_CHECKSUM_H
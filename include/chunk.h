@@ -0,0 +1,82 @@
+/*
+ * Copyright 2021 Chandradeep Dey
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef REPEAT_N_VIEW_CHUNK_H
+#define REPEAT_N_VIEW_CHUNK_H
+
+#include <cstddef>
+#include <iterator>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace repeat_n {
+// Segmented iteration: f(value, count) is called once for every run of count elements equal to value, in order.
+//
+// An iterator takes part by providing it.for_each_chunk(last, f), as the view iterators (one chunk) and the
+// rle_sequence iterators (one chunk per run) do. A range takes part by providing range.for_each_chunk(f), otherwise
+// its iterators are asked. Anything else is visited one element at a time with a count of 1.
+namespace detail {
+template <typename It, typename F>
+auto for_each_chunk(It first, It last, F &f, int) -> decltype(first.for_each_chunk(last, f), void()) {
+    first.for_each_chunk(last, f);
+}
+
+template <typename It, typename F> void for_each_chunk(It first, It last, F &f, long) {
+    for (; first != last; ++first) {
+        f(*first, std::size_t(1));
+    }
+}
+
+template <typename Range, typename F>
+auto for_each_chunk(const Range &range, F &f, int) -> decltype(range.for_each_chunk(f), void()) {
+    range.for_each_chunk(f);
+}
+
+template <typename Range, typename F> void for_each_chunk(const Range &range, F &f, long) {
+    using std::begin;
+    using std::end;
+    detail::for_each_chunk(begin(range), end(range), f, 0);
+}
+
+template <std::size_t I, typename Tuple, typename F>
+typename std::enable_if<I == std::tuple_size<Tuple>::value>::type for_each_chunk_of(const Tuple &, F &) {}
+
+template <std::size_t I, typename Tuple, typename F>
+typename std::enable_if<I != std::tuple_size<Tuple>::value>::type for_each_chunk_of(const Tuple &ranges, F &f) {
+    detail::for_each_chunk(std::get<I>(ranges), f, 0);
+    detail::for_each_chunk_of<I + 1>(ranges, f);
+}
+} // namespace detail
+
+template <typename It, typename F> F for_each_chunk(It first, It last, F f) {
+    detail::for_each_chunk(first, last, f, 0);
+    return f;
+}
+
+template <typename Range, typename F> F for_each_chunk(const Range &range, F f) {
+    detail::for_each_chunk(range, f, 0);
+    return f;
+}
+
+// the concatenation of the ranges, each one forwarding its own chunks; build it with std::tie or std::forward_as_tuple
+template <typename... Ranges, typename F> F for_each_chunk(const std::tuple<Ranges...> &ranges, F f) {
+    detail::for_each_chunk_of<0>(ranges, f);
+    return f;
+}
+} // namespace repeat_n
+
+#endif // REPEAT_N_VIEW_CHUNK_H
@@ -0,0 +1,66 @@
+/*
+ * Copyright 2021 Chandradeep Dey
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef REPEAT_N_VIEW_CONFIG_H
+#define REPEAT_N_VIEW_CONFIG_H
+
+#include <memory>
+
+#if defined(_MSVC_LANG)
+#define REPEAT_N_CPLUSPLUS _MSVC_LANG
+#else
+#define REPEAT_N_CPLUSPLUS __cplusplus
+#endif
+
+// C++11 constexpr functions are a single return statement, so the views only become usable in constant expressions
+// from C++14 on. std::reverse_iterator has to wait for C++17. The counters of instrument.h cannot be constexpr.
+#if REPEAT_N_CPLUSPLUS >= 201402L && !defined(REPEAT_N_INSTRUMENT)
+#define REPEAT_N_CONSTEXPR14 constexpr
+#else
+#define REPEAT_N_CONSTEXPR14
+#endif
+
+#if REPEAT_N_CPLUSPLUS >= 201703L && !defined(REPEAT_N_INSTRUMENT)
+#define REPEAT_N_CONSTEXPR17 constexpr
+#else
+#define REPEAT_N_CONSTEXPR17
+#endif
+
+// the std::ranges customisations in owned_view.h, foreign_view.h and ranges.h
+#if REPEAT_N_CPLUSPLUS >= 202002L
+#include <version>
+#endif
+
+#if defined(__cpp_lib_ranges)
+#define REPEAT_N_HAS_RANGES 1
+#else
+#define REPEAT_N_HAS_RANGES 0
+#endif
+
+namespace repeat_n {
+namespace detail {
+// std::addressof is only constexpr from C++17, the builtin behind it already is in C++14
+template <typename T> constexpr T *addressof(T &arg) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_addressof(arg);
+#else
+    return std::addressof(arg);
+#endif
+}
+} // namespace detail
+} // namespace repeat_n
+
+#endif // REPEAT_N_VIEW_CONFIG_H
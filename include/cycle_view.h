@@ -0,0 +1,247 @@
+/*
+ * Copyright 2021 Chandradeep Dey
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef REPEAT_N_VIEW_CYCLE_VIEW_H
+#define REPEAT_N_VIEW_CYCLE_VIEW_H
+
+#include "check.h"
+#include "fill_into.h"
+#include "traits.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <iterator>
+#include <limits>
+#include <type_traits>
+
+namespace repeat_n {
+// A foreign_view of a pattern of several elements instead of one: n repetitions of the length elements starting at
+// pattern, which has to outlive the view. It is not a repeat view in the sense of traits.h, so fold, parallel_fill,
+// io::write, mapped_span and the other functions that only read the first element do not accept it. fill_into has
+// the overload below, and rle_sequence::append and materialize.h take it element by element.
+template <typename T, typename Check = default_check> class cycle_view {
+  public: // types
+    using value_type = T;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using reference = typename std::add_lvalue_reference<typename std::add_const<T>::type>::type;
+    using const_reference = typename std::add_lvalue_reference<typename std::add_const<T>::type>::type;
+    using pointer = typename std::add_pointer<typename std::add_const<T>::type>::type;
+    using const_pointer = typename std::add_pointer<typename std::add_const<T>::type>::type;
+
+    class const_iterator {
+        // Iterator
+      public:
+        using value_type = cycle_view::value_type;
+        using difference_type = cycle_view::difference_type;
+        using reference = cycle_view::const_reference;
+        using pointer = cycle_view::const_pointer;
+        using iterator_category = std::random_access_iterator_tag;
+
+      public:
+        const_iterator(const const_iterator &other) = default;
+
+        const_iterator &operator=(const const_iterator &other) = default;
+
+        friend void swap(const_iterator &lhs, const_iterator &rhs) {
+            auto temp = lhs;
+            lhs = rhs;
+            rhs = temp;
+        }
+
+        reference operator*() const { return pattern[phase]; }
+
+        // phase is kept equal to curr % length by wrapping it, so stepping never divides
+        const_iterator &operator++() {
+            ++curr;
+            if (++phase == length) {
+                phase = 0;
+            }
+            return *this;
+        }
+
+        // InputIterator
+        friend bool operator==(const const_iterator &lhs, const const_iterator &rhs) {
+            Check::same_view(lhs.pattern, rhs.pattern, "Requested comparison between different views");
+            return lhs.curr == rhs.curr;
+        }
+
+        friend bool operator!=(const const_iterator &lhs, const const_iterator &rhs) { return !(lhs == rhs); }
+
+        pointer operator->() const { return &operator*(); }
+
+        const_iterator operator++(int) & {
+            auto prev = *this;
+            ++*this;
+            return prev;
+        }
+
+        // ForwardIterator
+        const_iterator() = default;
+
+        // BidirectionalIterator
+        const_iterator &operator--() {
+            --curr;
+            if (phase == 0) {
+                phase = length;
+            }
+            --phase;
+            return *this;
+        }
+
+        const_iterator operator--(int) & {
+            auto prev = *this;
+            --*this;
+            return prev;
+        }
+
+        // RandomAccessIterator
+        const_iterator &operator+=(difference_type n) {
+            curr += static_cast<size_type>(n);
+            phase = length == 0 ? 0 : curr % length;
+            return *this;
+        }
+
+        friend const_iterator operator+(const_iterator a, difference_type n) { return a += n; }
+
+        friend const_iterator operator+(difference_type n, const_iterator a) { return a + n; }
+
+        const_iterator &operator-=(difference_type n) { return operator+=(-n); }
+
+        friend const_iterator operator-(const_iterator a, difference_type n) { return a -= n; }
+
+        friend difference_type operator-(const const_iterator &a, const const_iterator &b) {
+            Check::same_view(a.pattern, b.pattern, "Requested difference between different views");
+            return static_cast<difference_type>(a.curr - b.curr);
+        }
+
+        reference operator[](difference_type n) const { return *(*this + n); }
+
+        friend bool operator<(const const_iterator &a, const const_iterator &b) {
+            Check::same_view(a.pattern, b.pattern, "Requested comparison between different views");
+            return a.curr < b.curr;
+        }
+
+        friend bool operator<=(const const_iterator &a, const const_iterator &b) {
+            Check::same_view(a.pattern, b.pattern, "Requested comparison between different views");
+            return a.curr <= b.curr;
+        }
+
+        friend bool operator>(const const_iterator &a, const const_iterator &b) { return !(a <= b); }
+
+        friend bool operator>=(const const_iterator &a, const const_iterator &b) { return !(a < b); }
+
+      private: // constructor only cycle_view can access
+        friend class cycle_view;
+
+        const_iterator(const_pointer p, size_type l, size_type c) noexcept
+            : pattern(p), length(l), curr(c), phase(l == 0 ? 0 : c % l) {}
+
+      private: // data members
+        const_pointer pattern = nullptr;
+        size_type length = 0;
+        size_type curr = 0;
+        size_type phase = 0; // curr % length
+    };
+
+    using iterator = const_iterator;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+    using reverse_iterator = const_reverse_iterator;
+
+  public: // constructors
+    // same argument order as the (size_type, value_type) constructors of the STL containers
+    cycle_view(size_type n, const_pointer pattern, size_type length) noexcept
+        : M_pattern(pattern), M_length(length), M_repetitions(n) {}
+
+  public: // pattern
+    const_pointer pattern() const noexcept { return M_pattern; }
+
+    size_type pattern_size() const noexcept { return M_length; }
+
+    size_type repetitions() const noexcept { return M_repetitions; }
+
+  public: // element access
+    const_reference operator[](size_type pos) const { return M_pattern[pos % M_length]; }
+
+  public: // iterators
+    const_iterator begin() const noexcept { return const_iterator(M_pattern, M_length, 0); }
+
+    const_iterator cbegin() const noexcept { return begin(); }
+
+    const_iterator end() const noexcept { return const_iterator(M_pattern, M_length, size()); }
+
+    const_iterator cend() const noexcept { return end(); }
+
+    const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(end()); }
+
+    const_reverse_iterator crbegin() const noexcept { return rbegin(); }
+
+    const_reverse_iterator rend() const noexcept { return const_reverse_iterator(begin()); }
+
+    const_reverse_iterator crend() const noexcept { return rend(); }
+
+  public: // capacity
+    size_type size() const noexcept { return M_repetitions * M_length; }
+
+    bool empty() const noexcept { return size() == 0; }
+
+    difference_type max_size() const noexcept { return std::numeric_limits<difference_type>::max(); }
+
+  private:
+    const_pointer M_pattern;
+    size_type M_length;
+    size_type M_repetitions;
+};
+
+static_assert(!is_repeat_view<cycle_view<int>>::value, "cycle_view has more than one element");
+
+namespace detail {
+// One copy of the pattern, then each memcpy copies everything written so far, doubling it, so N repetitions take
+// about log2(N) calls that each run at memcpy speed.
+template <typename T, typename Check> T *fill_cycle(const cycle_view<T, Check> &view, T *dest, std::true_type) {
+    const std::size_t total = view.size() * sizeof(T);
+    if (total == 0) {
+        return dest;
+    }
+    auto bytes = reinterpret_cast<unsigned char *>(dest);
+    std::size_t written = view.pattern_size() * sizeof(T);
+    std::memcpy(bytes, view.pattern(), written);
+    while (written < total) {
+        const std::size_t now = std::min(written, total - written);
+        std::memcpy(bytes + written, bytes, now);
+        written += now;
+    }
+    return dest + view.size();
+}
+
+template <typename T, typename Check, typename OutputIt>
+OutputIt fill_cycle(const cycle_view<T, Check> &view, OutputIt dest, std::false_type) {
+    return std::copy(view.begin(), view.end(), dest);
+}
+} // namespace detail
+
+// Writes the view's contents starting at dest, overloading the broadcast in fill_into.h, which only knows views of a
+// single element. A plain T * and trivially copyable T take the doubling memcpy above, whatever the store_mode.
+template <typename T, typename Check, typename OutputIt>
+OutputIt fill_into(const cycle_view<T, Check> &view, OutputIt dest, store_mode = store_mode::automatic) {
+    using memcpy_path =
+        std::integral_constant<bool, std::is_same<OutputIt, T *>::value && std::is_trivially_copyable<T>::value>;
+    return detail::fill_cycle(view, dest, memcpy_path{});
+}
+} // namespace repeat_n
+
+#endif // REPEAT_N_VIEW_CYCLE_VIEW_H
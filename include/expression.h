@@ -0,0 +1,168 @@
+/*
+ * Copyright 2021 Chandradeep Dey
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef REPEAT_N_VIEW_EXPRESSION_H
+#define REPEAT_N_VIEW_EXPRESSION_H
+
+#include "foreign_view.h"
+#include "owned_view.h"
+
+#include <cassert>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+namespace repeat_n {
+// Elementwise arithmetic over ranges of equal size, evaluated in one loop by evaluate_into. Start an expression with
+// elementwise(range) and combine it with +, -, * and / with other expressions or with views, for example
+//     evaluate_into(elementwise(a) * scale + bias, y.begin());
+// Views take part as a single copy of their element instead of through their iterators, which leaves a loop over
+// indices and plain values that the compiler can keep in a register and vectorize. Nothing is evaluated, and no
+// temporaries are made, before evaluate_into. Expressions refer to the ranges passed to elementwise, not copies.
+
+// a random access range, read through its begin() iterator
+template <typename RandomIt> class elementwise_range {
+  public:
+    elementwise_range(RandomIt first, std::size_t n) : M_first(first), M_size(n) {}
+
+    auto operator[](std::size_t i) const -> decltype(std::declval<const RandomIt &>()[i]) { return M_first[i]; }
+
+    std::size_t size() const noexcept { return M_size; }
+
+  private:
+    RandomIt M_first;
+    std::size_t M_size;
+};
+
+// a view, held as its size and one copy of its element
+template <typename T> class broadcast {
+  public:
+    broadcast(const T &value, std::size_t n) : M_value(value), M_size(n) {}
+
+    const T &operator[](std::size_t) const noexcept { return M_value; }
+
+    std::size_t size() const noexcept { return M_size; }
+
+  private:
+    T M_value;
+    std::size_t M_size;
+};
+
+template <typename Op, typename L, typename R> class elementwise_op {
+  public:
+    elementwise_op(const L &lhs, const R &rhs) : M_lhs(lhs), M_rhs(rhs) {
+        assert(lhs.size() == rhs.size() && "elementwise operands must have the same size");
+    }
+
+    auto operator[](std::size_t i) const
+        -> decltype(Op{}(std::declval<const L &>()[i], std::declval<const R &>()[i])) {
+        return Op{}(M_lhs[i], M_rhs[i]);
+    }
+
+    std::size_t size() const noexcept { return M_lhs.size(); }
+
+  private:
+    L M_lhs;
+    R M_rhs;
+};
+
+template <typename E> struct is_expression : std::false_type {};
+
+template <typename RandomIt> struct is_expression<elementwise_range<RandomIt>> : std::true_type {};
+
+template <typename T> struct is_expression<broadcast<T>> : std::true_type {};
+
+template <typename Op, typename L, typename R> struct is_expression<elementwise_op<Op, L, R>> : std::true_type {};
+
+namespace detail {
+// the transparent std::plus<> and friends are C++14
+#define REPEAT_N_ELEMENTWISE_FUNCTOR(name, op)                                                                         \
+    struct name {                                                                                                      \
+        template <typename A, typename B>                                                                              \
+        auto operator()(const A &a, const B &b) const -> decltype(a op b) {                                            \
+            return a op b;                                                                                             \
+        }                                                                                                              \
+    };
+REPEAT_N_ELEMENTWISE_FUNCTOR(add, +)
+REPEAT_N_ELEMENTWISE_FUNCTOR(subtract, -)
+REPEAT_N_ELEMENTWISE_FUNCTOR(multiply, *)
+REPEAT_N_ELEMENTWISE_FUNCTOR(divide, /)
+#undef REPEAT_N_ELEMENTWISE_FUNCTOR
+
+template <typename E, typename std::enable_if<is_expression<E>::value, bool>::type = true>
+const E &as_operand(const E &e) noexcept {
+    return e;
+}
+
+template <typename T, std::size_t N, typename Check, typename Layout>
+broadcast<T> as_operand(const owned_view<T, N, Check, Layout> &view) {
+    return broadcast<T>(view.data(), view.size());
+}
+
+// an empty foreign_view may not point at anything, so its element is only read when there is one
+template <typename T, std::size_t N, typename Check, typename Layout>
+broadcast<T> as_operand(const foreign_view<T, N, Check, Layout> &view) {
+    return broadcast<T>(view.size() == 0 ? T() : *view.begin(), view.size());
+}
+
+template <typename E> using operand_t = typename std::decay<decltype(as_operand(std::declval<const E &>()))>::type;
+
+// only when at least one side is an expression, so that the operators of iterators and numbers are left alone
+template <typename Op, typename L, typename R>
+using elementwise_result = typename std::enable_if<is_expression<L>::value || is_expression<R>::value,
+                                                   elementwise_op<Op, operand_t<L>, operand_t<R>>>::type;
+} // namespace detail
+
+template <typename Range>
+auto elementwise(const Range &range) -> elementwise_range<decltype(range.begin())> {
+    return elementwise_range<decltype(range.begin())>(range.begin(), range.size());
+}
+
+template <typename L, typename R>
+detail::elementwise_result<detail::add, L, R> operator+(const L &lhs, const R &rhs) {
+    return detail::elementwise_result<detail::add, L, R>(detail::as_operand(lhs), detail::as_operand(rhs));
+}
+
+template <typename L, typename R>
+detail::elementwise_result<detail::subtract, L, R> operator-(const L &lhs, const R &rhs) {
+    return detail::elementwise_result<detail::subtract, L, R>(detail::as_operand(lhs), detail::as_operand(rhs));
+}
+
+template <typename L, typename R>
+detail::elementwise_result<detail::multiply, L, R> operator*(const L &lhs, const R &rhs) {
+    return detail::elementwise_result<detail::multiply, L, R>(detail::as_operand(lhs), detail::as_operand(rhs));
+}
+
+template <typename L, typename R>
+detail::elementwise_result<detail::divide, L, R> operator/(const L &lhs, const R &rhs) {
+    return detail::elementwise_result<detail::divide, L, R>(detail::as_operand(lhs), detail::as_operand(rhs));
+}
+
+// Writes e[i] to dest[i] for every index and returns dest + e.size(). The loop runs over a local copy of e, which
+// dest cannot alias, so the broadcast values stay in registers.
+template <typename Expression, typename RandomIt,
+          typename std::enable_if<is_expression<Expression>::value, bool>::type = true>
+RandomIt evaluate_into(const Expression &expression, RandomIt dest) {
+    const Expression e = expression;
+    const std::size_t n = e.size();
+    for (std::size_t i = 0; i < n; ++i) {
+        dest[i] = e[i];
+    }
+    return dest + n;
+}
+} // namespace repeat_n
+
+#endif // REPEAT_N_VIEW_EXPRESSION_H
@@ -0,0 +1,49 @@
+/*
+ * Copyright 2021 Chandradeep Dey
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef REPEAT_N_VIEW_EXTENT_H
+#define REPEAT_N_VIEW_EXTENT_H
+
+#include "config.h"
+
+#include <cstddef>
+
+namespace repeat_n {
+// passing this as N makes the view take its size as a constructor argument
+constexpr std::size_t dynamic_extent = static_cast<std::size_t>(-1);
+
+namespace detail {
+// empty for a compile-time N so that the views stay the size of their contents
+template <std::size_t N> class extent {
+  protected:
+    extent() noexcept = default;
+
+    REPEAT_N_CONSTEXPR14 std::size_t M_extent() const noexcept { return N; }
+};
+
+template <> class extent<dynamic_extent> {
+  protected:
+    REPEAT_N_CONSTEXPR14 explicit extent(std::size_t n) noexcept : M_size(n) {}
+
+    REPEAT_N_CONSTEXPR14 std::size_t M_extent() const noexcept { return M_size; }
+
+  private:
+    std::size_t M_size;
+};
+} // namespace detail
+} // namespace repeat_n
+
+#endif // REPEAT_N_VIEW_EXTENT_H
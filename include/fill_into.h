@@ -0,0 +1,263 @@
+/*
+ * Copyright 2021 Chandradeep Dey
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef REPEAT_N_VIEW_FILL_INTO_H
+#define REPEAT_N_VIEW_FILL_INTO_H
+
+#include "traits.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <type_traits>
+
+// define REPEAT_N_NO_SIMD to always take the scalar path
+#if !defined(REPEAT_N_NO_SIMD) && defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define REPEAT_N_SIMD_X86 1
+#include <immintrin.h>
+#else
+#define REPEAT_N_SIMD_X86 0
+#endif
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <unistd.h>
+#endif
+
+namespace repeat_n {
+// non_temporal bypasses the cache, which only pays off when the output would not fit in it anyway
+enum class store_mode { automatic, temporal, non_temporal };
+
+namespace detail {
+namespace simd {
+enum class isa { scalar, sse2, avx2, avx512 };
+
+inline isa detect() noexcept {
+#if REPEAT_N_SIMD_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f")) {
+        return isa::avx512;
+    }
+    if (__builtin_cpu_supports("avx2")) {
+        return isa::avx2;
+    }
+    if (__builtin_cpu_supports("sse2")) {
+        return isa::sse2;
+    }
+#endif
+    return isa::scalar;
+}
+
+inline isa best() noexcept {
+    static const isa chosen = detect();
+    return chosen;
+}
+
+inline std::size_t width(isa which) noexcept {
+    switch (which) {
+    case isa::avx512:
+        return 64;
+    case isa::avx2:
+        return 32;
+    case isa::sse2:
+        return 16;
+    default:
+        return 0;
+    }
+}
+
+inline std::size_t llc_size() noexcept {
+#if defined(_SC_LEVEL3_CACHE_SIZE)
+    static const long l3 = sysconf(_SC_LEVEL3_CACHE_SIZE);
+    if (l3 > 0) {
+        return static_cast<std::size_t>(l3);
+    }
+#endif
+    return std::size_t(32) << 20;
+}
+
+// Each kernel stores whole vectors to an aligned dst and returns how many bytes it wrote. pattern holds the
+// element's bytes repeated and already rotated to line up with dst; period is sizeof the element, which divides 64,
+// so it also divides the four vector group and every register keeps its rotation across the loop.
+#if REPEAT_N_SIMD_X86
+__attribute__((target("sse2"))) inline std::size_t fill_sse2(unsigned char *dst, std::size_t bytes,
+                                                             const unsigned char *pattern, std::size_t period,
+                                                             bool stream) noexcept {
+    const std::size_t w = 16;
+    const __m128i r0 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(pattern));
+    const __m128i r1 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(pattern + w % period));
+    const __m128i r2 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(pattern + 2 * w % period));
+    const __m128i r3 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(pattern + 3 * w % period));
+    std::size_t done = 0;
+    if (stream) {
+        for (; done + 4 * w <= bytes; done += 4 * w) {
+            _mm_stream_si128(reinterpret_cast<__m128i *>(dst + done), r0);
+            _mm_stream_si128(reinterpret_cast<__m128i *>(dst + done + w), r1);
+            _mm_stream_si128(reinterpret_cast<__m128i *>(dst + done + 2 * w), r2);
+            _mm_stream_si128(reinterpret_cast<__m128i *>(dst + done + 3 * w), r3);
+        }
+        _mm_sfence();
+    } else {
+        for (; done + 4 * w <= bytes; done += 4 * w) {
+            _mm_store_si128(reinterpret_cast<__m128i *>(dst + done), r0);
+            _mm_store_si128(reinterpret_cast<__m128i *>(dst + done + w), r1);
+            _mm_store_si128(reinterpret_cast<__m128i *>(dst + done + 2 * w), r2);
+            _mm_store_si128(reinterpret_cast<__m128i *>(dst + done + 3 * w), r3);
+        }
+    }
+    const __m128i rest[] = {r0, r1, r2};
+    for (std::size_t j = 0; done + w <= bytes; ++j, done += w) {
+        _mm_store_si128(reinterpret_cast<__m128i *>(dst + done), rest[j]);
+    }
+    return done;
+}
+
+__attribute__((target("avx2"))) inline std::size_t fill_avx2(unsigned char *dst, std::size_t bytes,
+                                                             const unsigned char *pattern, std::size_t period,
+                                                             bool stream) noexcept {
+    const std::size_t w = 32;
+    const __m256i r0 = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(pattern));
+    const __m256i r1 = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(pattern + w % period));
+    const __m256i r2 = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(pattern + 2 * w % period));
+    const __m256i r3 = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(pattern + 3 * w % period));
+    std::size_t done = 0;
+    if (stream) {
+        for (; done + 4 * w <= bytes; done += 4 * w) {
+            _mm256_stream_si256(reinterpret_cast<__m256i *>(dst + done), r0);
+            _mm256_stream_si256(reinterpret_cast<__m256i *>(dst + done + w), r1);
+            _mm256_stream_si256(reinterpret_cast<__m256i *>(dst + done + 2 * w), r2);
+            _mm256_stream_si256(reinterpret_cast<__m256i *>(dst + done + 3 * w), r3);
+        }
+        _mm_sfence();
+    } else {
+        for (; done + 4 * w <= bytes; done += 4 * w) {
+            _mm256_store_si256(reinterpret_cast<__m256i *>(dst + done), r0);
+            _mm256_store_si256(reinterpret_cast<__m256i *>(dst + done + w), r1);
+            _mm256_store_si256(reinterpret_cast<__m256i *>(dst + done + 2 * w), r2);
+            _mm256_store_si256(reinterpret_cast<__m256i *>(dst + done + 3 * w), r3);
+        }
+    }
+    const __m256i rest[] = {r0, r1, r2};
+    for (std::size_t j = 0; done + w <= bytes; ++j, done += w) {
+        _mm256_store_si256(reinterpret_cast<__m256i *>(dst + done), rest[j]);
+    }
+    return done;
+}
+
+__attribute__((target("avx512f"))) inline std::size_t fill_avx512(unsigned char *dst, std::size_t bytes,
+                                                                  const unsigned char *pattern, std::size_t period,
+                                                                  bool stream) noexcept {
+    const std::size_t w = 64;
+    // every supported period divides 64, so all four registers hold the same bytes
+    const __m512i r0 = _mm512_loadu_si512(pattern);
+    (void)period;
+    std::size_t done = 0;
+    if (stream) {
+        for (; done + 4 * w <= bytes; done += 4 * w) {
+            _mm512_stream_si512(reinterpret_cast<__m512i *>(dst + done), r0);
+            _mm512_stream_si512(reinterpret_cast<__m512i *>(dst + done + w), r0);
+            _mm512_stream_si512(reinterpret_cast<__m512i *>(dst + done + 2 * w), r0);
+            _mm512_stream_si512(reinterpret_cast<__m512i *>(dst + done + 3 * w), r0);
+        }
+        _mm_sfence();
+    } else {
+        for (; done + 4 * w <= bytes; done += 4 * w) {
+            _mm512_store_si512(dst + done, r0);
+            _mm512_store_si512(dst + done + w, r0);
+            _mm512_store_si512(dst + done + 2 * w, r0);
+            _mm512_store_si512(dst + done + 3 * w, r0);
+        }
+    }
+    for (; done + w <= bytes; done += w) {
+        _mm512_store_si512(dst + done, r0);
+    }
+    return done;
+}
+#endif
+
+inline std::size_t fill_aligned(isa which, unsigned char *dst, std::size_t bytes, const unsigned char *pattern,
+                                std::size_t period, bool stream) noexcept {
+#if REPEAT_N_SIMD_X86
+    switch (which) {
+    case isa::avx512:
+        return fill_avx512(dst, bytes, pattern, period, stream);
+    case isa::avx2:
+        return fill_avx2(dst, bytes, pattern, period, stream);
+    case isa::sse2:
+        return fill_sse2(dst, bytes, pattern, period, stream);
+    default:
+        break;
+    }
+#else
+    (void)which, (void)dst, (void)bytes, (void)pattern, (void)period, (void)stream;
+#endif
+    return 0;
+}
+} // namespace simd
+
+template <typename T>
+struct is_broadcastable
+    : std::integral_constant<bool, std::is_trivially_copyable<T>::value && 64 % sizeof(T) == 0> {};
+
+template <typename T> T *broadcast_fill(const T &value, std::size_t n, T *dest, store_mode mode) {
+    const simd::isa which = simd::best();
+    const std::size_t w = simd::width(which);
+    const std::size_t bytes = n * sizeof(T);
+    if (w == 0 || bytes < 4 * w) {
+        return std::fill_n(dest, n, value);
+    }
+
+    // enough of the element's bytes that any rotation can still be loaded as a whole vector
+    unsigned char pattern[192];
+    for (std::size_t i = 0; i < sizeof(pattern); i += sizeof(T)) {
+        std::memcpy(pattern + i, std::addressof(value), sizeof(T));
+    }
+
+    auto dst = reinterpret_cast<unsigned char *>(dest);
+    const std::size_t head = (w - reinterpret_cast<std::uintptr_t>(dst) % w) % w;
+    std::memcpy(dst, pattern, head);
+
+    const bool stream = mode == store_mode::non_temporal || (mode == store_mode::automatic && bytes > simd::llc_size());
+    const unsigned char *rotated = pattern + head % sizeof(T);
+    const std::size_t done = simd::fill_aligned(which, dst + head, bytes - head, rotated, sizeof(T), stream);
+    std::memcpy(dst + head + done, rotated + done % sizeof(T), bytes - head - done);
+    return dest + n;
+}
+
+template <typename View, typename T> T *fill_into(const View &view, T *dest, store_mode mode, std::true_type) {
+    return view.size() == 0 ? dest : detail::broadcast_fill(*view.begin(), view.size(), dest, mode);
+}
+
+template <typename View, typename OutputIt>
+OutputIt fill_into(const View &view, OutputIt dest, store_mode, std::false_type) {
+    return std::copy(view.begin(), view.end(), dest);
+}
+} // namespace detail
+
+// Writes view.size() copies of the view's element starting at dest and returns the end of the written range.
+// Trivially copyable elements whose size divides 64 written to a plain pointer go through the widest broadcast
+// store loop the CPU supports, anything else walks the view's iterators. Only for views of one element, see traits.h.
+template <typename View, typename OutputIt, detail::enable_if_repeat_view<View> = true>
+OutputIt fill_into(const View &view, OutputIt dest, store_mode mode = store_mode::automatic) {
+    using value_type = typename View::value_type;
+    using simd_path = std::integral_constant<bool, std::is_same<OutputIt, value_type *>::value &&
+                                                       detail::is_broadcastable<value_type>::value>;
+    return detail::fill_into(view, dest, mode, simd_path{});
+}
+} // namespace repeat_n
+
+#endif // REPEAT_N_VIEW_FILL_INTO_H
@@ -0,0 +1,110 @@
+/*
+ * Copyright 2021 Chandradeep Dey
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef REPEAT_N_VIEW_FOLD_H
+#define REPEAT_N_VIEW_FOLD_H
+
+#include "config.h"
+#include "traits.h"
+
+#include <cmath>
+#include <cstddef>
+#include <functional>
+#include <type_traits>
+#include <utility>
+
+namespace repeat_n {
+namespace detail {
+template <typename T>
+struct is_plain_arithmetic
+    : std::integral_constant<bool, std::is_arithmetic<T>::value && !std::is_same<T, bool>::value> {};
+
+// which of the closed forms below applies to folding a U into a T with Op
+enum class fold_kind { squaring, sum, product };
+
+template <typename Op, typename T, typename U> struct fold_kind_of {
+    static constexpr fold_kind value = fold_kind::squaring;
+};
+
+template <typename T, typename U> struct fold_kind_of<std::plus<T>, T, U> {
+    static constexpr fold_kind value = is_plain_arithmetic<T>::value ? fold_kind::sum : fold_kind::squaring;
+};
+
+template <typename T, typename U> struct fold_kind_of<std::multiplies<T>, T, U> {
+    static constexpr fold_kind value =
+        std::is_floating_point<T>::value ? fold_kind::product : fold_kind::squaring;
+};
+
+#if REPEAT_N_CPLUSPLUS >= 201402L
+template <typename T, typename U> struct fold_kind_of<std::plus<>, T, U> {
+    // an integral accumulator truncates a floating point element at every step, which value * N would not
+    static constexpr fold_kind value = is_plain_arithmetic<T>::value && is_plain_arithmetic<U>::value &&
+                                               !(std::is_integral<T>::value && std::is_floating_point<U>::value)
+                                           ? fold_kind::sum
+                                           : fold_kind::squaring;
+};
+
+template <typename T, typename U> struct fold_kind_of<std::multiplies<>, T, U> {
+    static constexpr fold_kind value =
+        std::is_floating_point<T>::value && is_plain_arithmetic<U>::value ? fold_kind::product : fold_kind::squaring;
+};
+#endif
+
+template <fold_kind kind> using fold_tag = std::integral_constant<fold_kind, kind>;
+
+// x op x op ... op x is x to the power n under op, so square and multiply needs O(log n) applications of op
+template <typename U, typename BinaryOp, typename T>
+T fold(const U &value, std::size_t n, BinaryOp &op, T init, fold_tag<fold_kind::squaring>) {
+    if (n == 0) {
+        return init;
+    }
+    T power = value;
+    for (;;) {
+        if (n & 1) {
+            init = op(std::move(init), power);
+        }
+        n >>= 1;
+        if (n == 0) {
+            return init;
+        }
+        power = op(power, power);
+    }
+}
+
+template <typename U, typename BinaryOp, typename T>
+T fold(const U &value, std::size_t n, BinaryOp &, T init, fold_tag<fold_kind::sum>) {
+    return init + static_cast<T>(value) * static_cast<T>(n);
+}
+
+template <typename U, typename BinaryOp, typename T>
+T fold(const U &value, std::size_t n, BinaryOp &, T init, fold_tag<fold_kind::product>) {
+    return init * static_cast<T>(std::pow(static_cast<T>(value), static_cast<T>(n)));
+}
+} // namespace detail
+
+// Same result as std::accumulate(view.begin(), view.end(), init, op) for an associative op, computed with O(log N)
+// applications of op. std::plus on arithmetic types and std::multiplies on floating point types skip op altogether and
+// use value * N and pow(value, N), which can round differently from the sequential sum or product. Only for views of
+// one element, see traits.h.
+template <typename View, typename BinaryOp, typename T, detail::enable_if_repeat_view<View> = true>
+T fold(const View &view, BinaryOp op, T init) {
+    using value_type = typename View::value_type;
+    using kind = detail::fold_tag<detail::fold_kind_of<BinaryOp, T, value_type>::value>;
+    return view.size() == 0 ? init : detail::fold(*view.begin(), view.size(), op, std::move(init), kind{});
+}
+} // namespace repeat_n
+
+#endif // REPEAT_N_VIEW_FOLD_H
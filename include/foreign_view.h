@@ -17,15 +17,197 @@
 #ifndef REPEAT_N_VIEW_FOREIGN_VIEW_H
 #define REPEAT_N_VIEW_FOREIGN_VIEW_H
 
+#include "check.h"
+#include "config.h"
+#include "extent.h"
+#include "instrument.h"
+#include "layout.h"
+#include "sentinel.h"
+
+#include <algorithm>
 #include <cstddef>
 #include <iterator>
 #include <limits>
-#include <stdexcept>
 #include <type_traits>
 #include <utility>
 
 namespace repeat_n {
-template <typename T, std::size_t N = 1> class foreign_view {
+template <typename T, std::size_t N, typename Check, typename Layout> class foreign_view;
+
+// Shared by every foreign_view<T, N> whose N needs the same Counter, so that each count does not instantiate its own
+// iterator. See layout.h for the possible Counters.
+template <typename T, typename Check = default_check, typename Counter = std::size_t> class foreign_view_iterator {
+    // Iterator
+  public:
+    using value_type = T;
+    using difference_type = std::ptrdiff_t;
+    using reference = typename std::add_lvalue_reference<const T>::type;
+    using pointer = typename std::add_pointer<const T>::type;
+    using iterator_category = std::random_access_iterator_tag;
+
+  public:
+    foreign_view_iterator(const foreign_view_iterator &other) = default;
+
+    foreign_view_iterator &operator=(const foreign_view_iterator &other) = default;
+
+    friend REPEAT_N_CONSTEXPR14 void swap(foreign_view_iterator &lhs, foreign_view_iterator &rhs) {
+        auto temp = lhs;
+        lhs = rhs;
+        rhs = temp;
+    }
+
+    REPEAT_N_CONSTEXPR14 reference operator*() const {
+        REPEAT_N_COUNT(foreign_view_iterator, dereference);
+        return *position.location();
+    }
+
+    REPEAT_N_CONSTEXPR14 foreign_view_iterator &operator++() {
+        REPEAT_N_COUNT(foreign_view_iterator, increment);
+        position.advance(1);
+        return *this;
+    }
+
+    // InputIterator
+    friend REPEAT_N_CONSTEXPR14 bool operator==(const foreign_view_iterator &lhs, const foreign_view_iterator &rhs) {
+        REPEAT_N_COUNT_IF(lhs.position.location() != rhs.position.location(), foreign_view_iterator,
+                          cross_view_comparison);
+        Check::same_view(lhs.position.location(), rhs.position.location(),
+                         "Requested comparison between different views");
+        return lhs.position.count() == rhs.position.count();
+    }
+
+    friend REPEAT_N_CONSTEXPR14 bool operator!=(const foreign_view_iterator &lhs, const foreign_view_iterator &rhs) {
+        return !(lhs == rhs);
+    }
+
+    REPEAT_N_CONSTEXPR14 pointer operator->() const { return &operator*(); }
+
+    REPEAT_N_CONSTEXPR14 foreign_view_iterator operator++(int) & {
+        auto prev = *this;
+        ++*this;
+        return prev;
+    }
+
+    // ForwardIterator
+    foreign_view_iterator() = default;
+
+    // BidirectionalIterator
+    REPEAT_N_CONSTEXPR14 foreign_view_iterator &operator--() {
+        REPEAT_N_COUNT(foreign_view_iterator, decrement);
+        position.advance(-1);
+        return *this;
+    }
+
+    REPEAT_N_CONSTEXPR14 foreign_view_iterator operator--(int) & {
+        auto prev = *this;
+        --*this;
+        return prev;
+    }
+
+    // RandomAccessIterator
+    REPEAT_N_CONSTEXPR14 foreign_view_iterator &operator+=(difference_type n) noexcept {
+        REPEAT_N_COUNT(foreign_view_iterator, jump);
+        position.advance(n);
+        return *this;
+    }
+
+    friend REPEAT_N_CONSTEXPR14 foreign_view_iterator operator+(foreign_view_iterator a, difference_type n) noexcept {
+        return a += n;
+    }
+
+    friend REPEAT_N_CONSTEXPR14 foreign_view_iterator operator+(difference_type n, foreign_view_iterator a) noexcept {
+        return a + n;
+    }
+
+    REPEAT_N_CONSTEXPR14 foreign_view_iterator &operator-=(difference_type n) noexcept { return operator+=(-n); }
+
+    friend REPEAT_N_CONSTEXPR14 foreign_view_iterator operator-(foreign_view_iterator a, difference_type n) noexcept {
+        return a -= n;
+    }
+
+    friend REPEAT_N_CONSTEXPR14 difference_type operator-(const foreign_view_iterator &a,
+                                                          const foreign_view_iterator &b) {
+        REPEAT_N_COUNT_IF(a.position.location() != b.position.location(), foreign_view_iterator,
+                          cross_view_comparison);
+        Check::same_view(a.position.location(), b.position.location(), "Requested difference between different views");
+        // widened first, an unsigned counter would otherwise wrap instead of going negative
+        return static_cast<difference_type>(a.position.count()) - static_cast<difference_type>(b.position.count());
+    }
+
+    // every element is the same object
+    REPEAT_N_CONSTEXPR14 reference operator[](difference_type) const noexcept {
+        REPEAT_N_COUNT(foreign_view_iterator, dereference);
+        return *position.location();
+    }
+
+    friend REPEAT_N_CONSTEXPR14 bool operator<(const foreign_view_iterator &a, const foreign_view_iterator &b) {
+        REPEAT_N_COUNT_IF(a.position.location() != b.position.location(), foreign_view_iterator,
+                          cross_view_comparison);
+        Check::same_view(a.position.location(), b.position.location(), "Requested comparison between different views");
+        return a.position.count() < b.position.count();
+    }
+
+    friend REPEAT_N_CONSTEXPR14 bool operator<=(const foreign_view_iterator &a, const foreign_view_iterator &b) {
+        REPEAT_N_COUNT_IF(a.position.location() != b.position.location(), foreign_view_iterator,
+                          cross_view_comparison);
+        Check::same_view(a.position.location(), b.position.location(), "Requested comparison between different views");
+        return a.position.count() <= b.position.count();
+    }
+
+    friend REPEAT_N_CONSTEXPR14 bool operator>(const foreign_view_iterator &a, const foreign_view_iterator &b) {
+        return !(a <= b);
+    }
+
+    friend REPEAT_N_CONSTEXPR14 bool operator>=(const foreign_view_iterator &a, const foreign_view_iterator &b) {
+        return !(a < b);
+    }
+
+  public: // the end as a counted_sentinel, see sentinel.h
+    friend REPEAT_N_CONSTEXPR14 bool operator==(const foreign_view_iterator &it, counted_sentinel s) noexcept {
+        return static_cast<std::size_t>(it.position.count()) == s.count;
+    }
+
+    friend REPEAT_N_CONSTEXPR14 bool operator==(counted_sentinel s, const foreign_view_iterator &it) noexcept {
+        return it == s;
+    }
+
+    friend REPEAT_N_CONSTEXPR14 bool operator!=(const foreign_view_iterator &it, counted_sentinel s) noexcept {
+        return !(it == s);
+    }
+
+    friend REPEAT_N_CONSTEXPR14 bool operator!=(counted_sentinel s, const foreign_view_iterator &it) noexcept {
+        return !(it == s);
+    }
+
+    friend REPEAT_N_CONSTEXPR14 difference_type operator-(counted_sentinel s,
+                                                          const foreign_view_iterator &it) noexcept {
+        return static_cast<difference_type>(s.count) - static_cast<difference_type>(it.position.count());
+    }
+
+    friend REPEAT_N_CONSTEXPR14 difference_type operator-(const foreign_view_iterator &it,
+                                                          counted_sentinel s) noexcept {
+        return -(s - it);
+    }
+
+  public: // segmented iteration, see chunk.h
+    template <typename F> void for_each_chunk(const foreign_view_iterator &last, F &&f) const {
+        auto n = last - *this;
+        if (n > 0) {
+            f(*position.location(), static_cast<std::size_t>(n));
+        }
+    }
+
+  private: // constructor only foreign_view can access
+    template <typename, std::size_t, typename, typename> friend class foreign_view;
+
+    REPEAT_N_CONSTEXPR14 foreign_view_iterator(pointer l, std::size_t c) : position(l, c) {}
+
+  private: // data members
+    detail::cursor<pointer, Counter> position;
+};
+
+template <typename T, std::size_t N = 1, typename Check = default_check, typename Layout = plain>
+class foreign_view : private detail::extent<N> {
   public: // types
     using value_type = T;
     using size_type = std::size_t;
@@ -34,148 +216,77 @@ template <typename T, std::size_t N = 1> class foreign_view {
     using const_reference = typename std::add_lvalue_reference<typename std::add_const<T>::type>::type;
     using pointer = typename std::add_pointer<T>::type;
     using const_pointer = typename std::add_pointer<typename std::add_const<T>::type>::type;
-
-    class const_iterator {
-        // Iterator
-      public:
-        using value_type = foreign_view::value_type;
-        using difference_type = foreign_view::difference_type;
-        using reference = foreign_view::const_reference;
-        using pointer = foreign_view::const_pointer;
-        using iterator_category = std::random_access_iterator_tag;
-
-      public:
-        const_iterator(const const_iterator &other) = default;
-
-        const_iterator &operator=(const const_iterator &other) = default;
-
-        friend void swap(const_iterator &lhs, const_iterator &rhs) {
-            auto temp = lhs;
-            lhs = rhs;
-            rhs = temp;
-        }
-
-        reference operator*() const { return *location; }
-
-        const_iterator &operator++() {
-            ++curr;
-            return *this;
-        }
-
-        // InputIterator
-        friend bool operator==(const const_iterator &lhs, const const_iterator &rhs) {
-            if (lhs.location != rhs.location) {
-                throw std::invalid_argument("Requested comparison between different views");
-            }
-            return lhs.curr == rhs.curr;
-        }
-
-        friend bool operator!=(const const_iterator &lhs, const const_iterator &rhs) { return !(lhs == rhs); }
-
-        pointer operator->() const { return &operator*(); }
-
-        const_iterator operator++(int) & {
-            auto prev = *this;
-            ++*this;
-            return prev;
-        }
-
-        // ForwardIterator
-        const_iterator() = default;
-
-        // BidirectionalIterator
-        const_iterator &operator--() {
-            --curr;
-            return *this;
-        }
-
-        const_iterator operator--(int) & {
-            auto prev = *this;
-            --*this;
-            return prev;
-        }
-
-        // RandomAccessIterator
-        const_iterator &operator+=(difference_type n) noexcept {
-            curr += n;
-            return *this;
-        }
-
-        friend const_iterator operator+(const_iterator a, difference_type n) noexcept { return a += n; }
-
-        friend const_iterator operator+(difference_type n, const_iterator a) noexcept { return a + n; }
-
-        const_iterator &operator-=(difference_type n) noexcept { return operator+=(-n); }
-
-        friend const_iterator operator-(const_iterator a, difference_type n) noexcept { return a -= n; }
-
-        friend difference_type operator-(const const_iterator &a, const const_iterator &b) {
-            if (a.location != b.location) {
-                throw std::invalid_argument("Requested difference between different views");
-            }
-            return a.curr - b.curr;
-        }
-
-        reference operator[](difference_type n) noexcept { return *(location + n); }
-
-        friend bool operator<(const const_iterator &a, const const_iterator &b) {
-            if (a.location != b.location) {
-                throw std::invalid_argument("Requested comparison between different views");
-            }
-            return a.curr < b.curr;
-        }
-
-        friend bool operator<=(const const_iterator &a, const const_iterator &b) {
-            if (a.location != b.location) {
-                throw std::invalid_argument("Requested comparison between different views");
-            }
-            return a.curr <= b.curr;
-        }
-
-        friend bool operator>(const const_iterator &a, const const_iterator &b) { return !(a <= b); }
-
-        friend bool operator>=(const const_iterator &a, const const_iterator &b) { return !(a < b); }
-
-      private: // constructor only foreign_view can access
-        friend class foreign_view;
-
-        const_iterator(pointer l, std::size_t c) : location(l), curr(c) {}
-
-      private: // data members
-        pointer location = nullptr;
-        std::size_t curr = 0;
-    };
-
+    using const_iterator = foreign_view_iterator<T, Check, detail::counter_t<N, Layout>>;
     using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+    using subview_type = foreign_view<T, dynamic_extent, Check, Layout>;
 
   public: // constructors
-    explicit foreign_view(const_pointer outsider) : M_contents(outsider) {}
+    template <std::size_t M = N, typename std::enable_if<M != dynamic_extent, bool>::type = true>
+    REPEAT_N_CONSTEXPR14 explicit foreign_view(const_pointer outsider) : M_contents(outsider) {
+        REPEAT_N_COUNT(foreign_view, view_constructed);
+    }
+
+    // same argument order as the (size_type, value_type) constructors of the STL containers
+    template <std::size_t M = N, typename std::enable_if<M == dynamic_extent, bool>::type = true>
+    REPEAT_N_CONSTEXPR14 explicit foreign_view(size_type n, const_pointer outsider)
+        : detail::extent<N>(n), M_contents(outsider) {
+        REPEAT_N_COUNT(foreign_view, view_constructed);
+    }
 
   public: // iterators
-    const_iterator begin() const noexcept { return const_iterator(M_contents, 0); }
+    REPEAT_N_CONSTEXPR14 const_iterator begin() const noexcept { return const_iterator(M_contents, 0); }
 
-    const_iterator cbegin() const noexcept { return const_iterator(M_contents, 0); }
+    REPEAT_N_CONSTEXPR14 const_iterator cbegin() const noexcept { return const_iterator(M_contents, 0); }
 
-    const_iterator end() const noexcept { return const_iterator(M_contents, N); }
+    REPEAT_N_CONSTEXPR14 const_iterator end() const noexcept { return const_iterator(M_contents, size()); }
 
-    const_iterator cend() const noexcept { return const_iterator(M_contents, N); }
+    REPEAT_N_CONSTEXPR14 const_iterator cend() const noexcept { return const_iterator(M_contents, size()); }
 
-    const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(end()); }
+    REPEAT_N_CONSTEXPR17 const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(end()); }
 
-    const_reverse_iterator crbegin() const noexcept { return const_reverse_iterator(cend()); }
+    REPEAT_N_CONSTEXPR17 const_reverse_iterator crbegin() const noexcept { return const_reverse_iterator(cend()); }
 
-    const_reverse_iterator rend() const noexcept { return const_reverse_iterator(begin()); }
+    REPEAT_N_CONSTEXPR17 const_reverse_iterator rend() const noexcept { return const_reverse_iterator(begin()); }
 
-    const_reverse_iterator crend() const noexcept { return const_reverse_iterator(cbegin()); }
+    REPEAT_N_CONSTEXPR17 const_reverse_iterator crend() const noexcept { return const_reverse_iterator(cbegin()); }
 
   public: // capacity
-    size_type size() const noexcept { return N; }
+    REPEAT_N_CONSTEXPR14 size_type size() const noexcept { return this->M_extent(); }
 
-    difference_type max_size() const noexcept { return std::numeric_limits<difference_type>::max(); }
+    REPEAT_N_CONSTEXPR14 difference_type max_size() const noexcept {
+        return std::numeric_limits<difference_type>::max();
+    }
+
+  public: // sub-ranges in O(1), pointing at the same element as this view
+    // like std::basic_string_view::substr, count is clamped to what is left after pos
+    REPEAT_N_CONSTEXPR14 subview_type subview(size_type pos, size_type count = dynamic_extent) const noexcept {
+        return subview_type(std::min(count, size() - std::min(pos, size())), M_contents);
+    }
+
+    // the first half gets the smaller share of an odd size
+    REPEAT_N_CONSTEXPR14 std::pair<subview_type, subview_type> split() const noexcept {
+        return std::make_pair(subview(0, size() / 2), subview(size() / 2));
+    }
 
   private:
     const_pointer M_contents;
 };
 } // namespace repeat_n
 
+#if REPEAT_N_HAS_RANGES
+#include <ranges>
+
+// A foreign_view is a pointer and a size, so it is a view, and its iterators point at the element it was given rather
+// than into the view, so they stay valid after the view is gone.
+namespace std {
+namespace ranges {
+template <typename T, std::size_t N, typename Check, typename Layout>
+inline constexpr bool enable_view<repeat_n::foreign_view<T, N, Check, Layout>> = true;
+
+template <typename T, std::size_t N, typename Check, typename Layout>
+inline constexpr bool enable_borrowed_range<repeat_n::foreign_view<T, N, Check, Layout>> = true;
+} // namespace ranges
+} // namespace std
+#endif
+
 #endif // REPEAT_N_VIEW_FOREIGN_VIEW_H
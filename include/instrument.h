@@ -0,0 +1,169 @@
+/*
+ * Copyright 2021 Chandradeep Dey
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef REPEAT_N_VIEW_INSTRUMENT_H
+#define REPEAT_N_VIEW_INSTRUMENT_H
+
+// Define REPEAT_N_INSTRUMENT, in every translation unit, to have owned_view, foreign_view and their iterators count
+// what is done with them, per type and per thread, until instrument::snapshot() or instrument::dump() sums them up.
+// Without it the counting macros expand to a no-op that does not evaluate its arguments, this header includes nothing
+// else, and the views compile to exactly what they did before. With it the views are no longer constexpr.
+#ifndef REPEAT_N_INSTRUMENT
+#define REPEAT_N_COUNT(type, what) static_cast<void>(0)
+#define REPEAT_N_COUNT_IF(condition, type, what) static_cast<void>(0)
+#else
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <mutex>
+#include <string>
+#include <typeinfo>
+#include <utility>
+#include <vector>
+
+namespace repeat_n {
+namespace instrument {
+// event counts for one view or iterator type
+struct counters {
+    std::uint64_t dereferences = 0;
+    std::uint64_t increments = 0; // ++
+    std::uint64_t decrements = 0; // --
+    std::uint64_t jumps = 0;      // += and -=, and so + and -
+    std::uint64_t cross_view_comparisons = 0;
+    std::uint64_t views_constructed = 0;
+
+    counters &operator+=(const counters &other) noexcept {
+        dereferences += other.dereferences;
+        increments += other.increments;
+        decrements += other.decrements;
+        jumps += other.jumps;
+        cross_view_comparisons += other.cross_view_comparisons;
+        views_constructed += other.views_constructed;
+        return *this;
+    }
+};
+
+enum class event { dereference, increment, decrement, jump, cross_view_comparison, view_constructed };
+
+namespace detail {
+class thread_slot;
+
+// Every live thread_slot, and the totals of those whose threads have exited. Leaked on purpose so that slots of
+// threads outliving static destruction can still retire into it.
+struct registry {
+    std::mutex mutex;
+    std::vector<thread_slot *> live;
+    std::map<std::string, counters> retired;
+
+    static registry &get() {
+        static registry *instance = new registry;
+        return *instance;
+    }
+};
+
+// One thread's counts for one type. Only its own thread writes them, with relaxed loads and stores rather than
+// read-modify-write instructions, which lets other threads read them at any time without a lock on the hot path.
+class thread_slot {
+  public:
+    explicit thread_slot(const std::type_info &type) : M_type(type) {
+        registry &r = registry::get();
+        std::lock_guard<std::mutex> lock(r.mutex);
+        r.live.push_back(this);
+    }
+
+    thread_slot(const thread_slot &) = delete;
+
+    thread_slot &operator=(const thread_slot &) = delete;
+
+    ~thread_slot() {
+        registry &r = registry::get();
+        std::lock_guard<std::mutex> lock(r.mutex);
+        r.retired[name()] += read();
+        for (auto it = r.live.begin(); it != r.live.end(); ++it) {
+            if (*it == this) {
+                r.live.erase(it);
+                break;
+            }
+        }
+    }
+
+    void count(event e) noexcept {
+        std::atomic<std::uint64_t> &c = M_counts[static_cast<int>(e)];
+        c.store(c.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    }
+
+    counters read() const noexcept {
+        counters c;
+        c.dereferences = M_counts[0].load(std::memory_order_relaxed);
+        c.increments = M_counts[1].load(std::memory_order_relaxed);
+        c.decrements = M_counts[2].load(std::memory_order_relaxed);
+        c.jumps = M_counts[3].load(std::memory_order_relaxed);
+        c.cross_view_comparisons = M_counts[4].load(std::memory_order_relaxed);
+        c.views_constructed = M_counts[5].load(std::memory_order_relaxed);
+        return c;
+    }
+
+    std::string name() const { return M_type.name(); }
+
+  private:
+    const std::type_info &M_type;
+    std::atomic<std::uint64_t> M_counts[6] = {};
+};
+
+template <typename Type> void count(event e) noexcept {
+    thread_local thread_slot slot(typeid(Type));
+    slot.count(e);
+}
+} // namespace detail
+
+// The counts of every type used so far, summed over all threads, keyed by the implementation's typeid name
+inline std::map<std::string, counters> snapshot() {
+    detail::registry &r = detail::registry::get();
+    std::lock_guard<std::mutex> lock(r.mutex);
+    std::map<std::string, counters> totals = r.retired;
+    for (const detail::thread_slot *slot : r.live) {
+        totals[slot->name()] += slot->read();
+    }
+    return totals;
+}
+
+inline void dump(std::FILE *out = stderr) {
+    std::fprintf(out, "%14s %14s %14s %14s %14s %14s  %s\n", "dereferences", "increments", "decrements", "jumps",
+                 "cross_view", "views", "type");
+    for (const auto &entry : snapshot()) {
+        const counters &c = entry.second;
+        std::fprintf(out, "%14llu %14llu %14llu %14llu %14llu %14llu  %s\n",
+                     static_cast<unsigned long long>(c.dereferences), static_cast<unsigned long long>(c.increments),
+                     static_cast<unsigned long long>(c.decrements), static_cast<unsigned long long>(c.jumps),
+                     static_cast<unsigned long long>(c.cross_view_comparisons),
+                     static_cast<unsigned long long>(c.views_constructed), entry.first.c_str());
+    }
+}
+
+// dumps to stderr when the program exits normally
+inline void dump_at_exit() {
+    std::atexit([] { dump(stderr); });
+}
+} // namespace instrument
+} // namespace repeat_n
+
+#define REPEAT_N_COUNT(type, what) ::repeat_n::instrument::detail::count<type>(::repeat_n::instrument::event::what)
+#define REPEAT_N_COUNT_IF(condition, type, what) ((condition) ? REPEAT_N_COUNT(type, what) : static_cast<void>(0))
+#endif
+
+#endif // REPEAT_N_VIEW_INSTRUMENT_H
@@ -0,0 +1,131 @@
+/*
+ * Copyright 2021 Chandradeep Dey
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef REPEAT_N_VIEW_INTERNED_VIEW_H
+#define REPEAT_N_VIEW_INTERNED_VIEW_H
+
+#include "check.h"
+#include "extent.h"
+#include "foreign_view.h"
+#include "layout.h"
+#include "traits.h"
+
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <type_traits>
+#include <unordered_set>
+#include <utility>
+
+namespace repeat_n {
+// what an intern_table holds, and what the values interned into it would have taken as separate copies, both
+// counted as sizeof(T) per value and so leaving out anything T allocates itself
+struct intern_stats {
+    std::size_t requests = 0; // calls to intern
+    std::size_t values = 0;   // distinct values stored
+    std::size_t bytes_stored = 0;
+    std::size_t bytes_saved = 0;
+};
+
+// Keeps one immutable copy of every distinct value it is given, for as long as the table lives. Its address is what
+// intern returns for that value and all equal ones. Thread safe. global() is shared by the whole program; a
+// thread_local table avoids the lock, but its values die with the thread.
+template <typename T, typename Hash = std::hash<T>, typename KeyEqual = std::equal_to<T>> class intern_table {
+  public:
+    intern_table() = default;
+
+    intern_table(const intern_table &) = delete;
+
+    intern_table &operator=(const intern_table &) = delete;
+
+    static intern_table &global() {
+        static intern_table table;
+        return table;
+    }
+
+    template <typename U> const T *intern(U &&value) {
+        std::lock_guard<std::mutex> lock(M_mutex);
+        ++M_requests;
+        // the nodes of an unordered_set never move, so the address stays valid through rehashing
+        return &*M_values.insert(std::forward<U>(value)).first;
+    }
+
+    intern_stats stats() const {
+        std::lock_guard<std::mutex> lock(M_mutex);
+        intern_stats s;
+        s.requests = M_requests;
+        s.values = M_values.size();
+        s.bytes_stored = s.values * sizeof(T);
+        s.bytes_saved = (s.requests - s.values) * sizeof(T);
+        return s;
+    }
+
+  private:
+    mutable std::mutex M_mutex;
+    std::unordered_set<T, Hash, KeyEqual> M_values;
+    std::size_t M_requests = 0;
+};
+
+// A foreign_view of a value in an intern_table, intern_table<T>::global() unless another one is given. Views of equal
+// values from the same table point at the same object, so comparing or hashing two views only looks at that
+// address and the size. Views from different tables never compare equal.
+template <typename T, std::size_t N = 1, typename Check = default_check, typename Layout = plain>
+class interned_view : public foreign_view<T, N, Check, Layout> {
+    using base = foreign_view<T, N, Check, Layout>;
+
+  public: // types
+    using table_type = intern_table<T>;
+    using typename base::const_pointer;
+    using typename base::size_type;
+
+  public: // constructors
+    template <std::size_t M = N, typename std::enable_if<M != dynamic_extent, bool>::type = true>
+    explicit interned_view(const T &value) : base(table_type::global().intern(value)) {}
+
+    template <std::size_t M = N, typename std::enable_if<M != dynamic_extent, bool>::type = true>
+    interned_view(table_type &table, const T &value) : base(table.intern(value)) {}
+
+    // same argument order as the (size_type, value_type) constructors of the STL containers
+    template <std::size_t M = N, typename std::enable_if<M == dynamic_extent, bool>::type = true>
+    explicit interned_view(size_type n, const T &value) : base(n, table_type::global().intern(value)) {}
+
+    template <std::size_t M = N, typename std::enable_if<M == dynamic_extent, bool>::type = true>
+    interned_view(table_type &table, size_type n, const T &value) : base(n, table.intern(value)) {}
+
+  public: // identity
+    const_pointer address() const noexcept { return this->begin().operator->(); }
+
+    friend bool operator==(const interned_view &lhs, const interned_view &rhs) noexcept {
+        return lhs.address() == rhs.address() && lhs.size() == rhs.size();
+    }
+
+    friend bool operator!=(const interned_view &lhs, const interned_view &rhs) noexcept { return !(lhs == rhs); }
+};
+
+template <typename T, std::size_t N, typename Check, typename Layout>
+struct is_repeat_view<interned_view<T, N, Check, Layout>> : std::true_type {};
+} // namespace repeat_n
+
+namespace std {
+template <typename T, std::size_t N, typename Check, typename Layout>
+struct hash<repeat_n::interned_view<T, N, Check, Layout>> {
+    std::size_t operator()(const repeat_n::interned_view<T, N, Check, Layout> &view) const noexcept {
+        return std::hash<const T *>()(view.address()) ^ static_cast<std::size_t>(view.size() * 0x9e3779b97f4a7c15ull);
+    }
+};
+} // namespace std
+
+#endif // REPEAT_N_VIEW_INTERNED_VIEW_H
@@ -0,0 +1,111 @@
+/*
+ * Copyright 2021 Chandradeep Dey
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef REPEAT_N_VIEW_IO_H
+#define REPEAT_N_VIEW_IO_H
+
+#if defined(__unix__) || defined(__APPLE__)
+#include "traits.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <climits>
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+#include <sys/types.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+namespace repeat_n {
+namespace io {
+namespace detail {
+constexpr std::size_t pattern_bytes = 4096;
+
+#ifdef IOV_MAX
+constexpr int max_iovecs = IOV_MAX < 1024 ? IOV_MAX : 1024;
+#else
+constexpr int max_iovecs = 16;
+#endif
+
+// Writes total bytes of the periodic sequence held in pattern, whose length is a multiple of the period, with each
+// iovec pointing back into pattern. A partial write only moves the position along; since the pattern is periodic the
+// next writev just starts that far into it.
+inline ssize_t write_pattern(int fd, const unsigned char *pattern, std::size_t length, std::size_t total) {
+    iovec iov[max_iovecs];
+    std::size_t done = 0;
+    while (done < total) {
+        std::size_t offset = done % length;
+        std::size_t queued = 0;
+        int count = 0;
+        for (; count < max_iovecs && done + queued < total; ++count) {
+            const std::size_t bytes = std::min(length - offset, total - done - queued);
+            iov[count].iov_base = const_cast<unsigned char *>(pattern + offset);
+            iov[count].iov_len = bytes;
+            queued += bytes;
+            offset = 0;
+        }
+        const ssize_t written = ::writev(fd, iov, count);
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            // like write(2), an error after some bytes went out reports those bytes, errno tells why it stopped
+            return done == 0 ? -1 : static_cast<ssize_t>(done);
+        }
+        done += static_cast<std::size_t>(written);
+    }
+    return static_cast<ssize_t>(done);
+}
+} // namespace detail
+
+// Writes the bytes of view.size() copies of the view's element to fd, like write(2) on a buffer holding them, but
+// from a single page of the pattern that every iovec of a writev points into. Memory use does not depend on the size
+// of the view and every call to writev covers up to a thousand pages. Partial writes are continued and EINTR is
+// retried. Returns the number of bytes written, which is short if writev failed part way, or -1 with errno set if it
+// failed before writing anything. Only for views of one element, see traits.h.
+template <typename View, repeat_n::detail::enable_if_repeat_view<View> = true> ssize_t write(int fd, const View &view) {
+    using T = typename View::value_type;
+    static_assert(std::is_trivially_copyable<T>::value, "io::write writes the object representation of T");
+    const std::size_t n = view.size();
+    if (n == 0) {
+        return 0;
+    }
+    const T &value = *view.begin();
+    // as many whole elements as fit in a page, or a single one when T is larger than that
+    const std::size_t per_pattern = std::max<std::size_t>(1, detail::pattern_bytes / sizeof(T));
+    const std::size_t length = std::min(per_pattern, n) * sizeof(T);
+
+    unsigned char page[detail::pattern_bytes];
+    std::vector<unsigned char> large;
+    unsigned char *pattern = page;
+    if (length > sizeof(page)) {
+        large.resize(length);
+        pattern = large.data();
+    }
+    for (std::size_t i = 0; i < length; i += sizeof(T)) {
+        std::memcpy(pattern + i, std::addressof(value), sizeof(T));
+    }
+    return detail::write_pattern(fd, pattern, length, n * sizeof(T));
+}
+} // namespace io
+} // namespace repeat_n
+#endif
+
+#endif // REPEAT_N_VIEW_IO_H
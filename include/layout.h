@@ -0,0 +1,139 @@
+/*
+ * Copyright 2021 Chandradeep Dey
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef REPEAT_N_VIEW_LAYOUT_H
+#define REPEAT_N_VIEW_LAYOUT_H
+
+#include "config.h"
+#include "extent.h"
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+// tagged assumes user space addresses fit in the low 48 bits, which leaves the top 16 for a counter. That holds on
+// x86-64 with 4-level paging, and with 5-level paging (LA57) as long as the process never asks mmap for an address
+// above 2^47, which Linux otherwise does not hand out. It does not hold for pointers carrying tags in their high bits,
+// such as those of Intel LAM, or on AArch64, where the top byte holds the tags of TBI and MTE (which Android's heap
+// uses by default). Debug builds assert that a pointer has nothing in its top 16 bits before tagging it. Define this
+// to 0 to turn tagged into compact where the assumption does not hold.
+#ifndef REPEAT_N_CAN_TAG_POINTERS
+#if defined(__x86_64__) || defined(_M_X64)
+#define REPEAT_N_CAN_TAG_POINTERS 1
+#else
+#define REPEAT_N_CAN_TAG_POINTERS 0
+#endif
+#endif
+
+namespace repeat_n {
+// How iterators store their position. plain, the default, counts with std::size_t as iterators always have. compact
+// uses the smallest unsigned type that can count to N, which only makes the iterator smaller where pointers are no
+// wider than that type: with 64 bit pointers the alignment pads it back to two pointers. tagged keeps a counter of up
+// to 16 bits in the unused high bits of the pointer, halving the iterator on x86-64, under the address assumption
+// above; elsewhere it is the same as compact, and it cannot be constexpr. None of them changes anything for
+// dynamic_extent.
+struct plain {};
+struct compact {};
+struct tagged {};
+
+// the Counter of an iterator whose count lives in the pointer
+struct tagged_counter {};
+
+namespace detail {
+template <std::size_t N>
+using smallest_counter = typename std::conditional<
+    N <= UINT8_MAX, std::uint8_t,
+    typename std::conditional<
+        N <= UINT16_MAX, std::uint16_t,
+        typename std::conditional<N <= UINT32_MAX, std::uint32_t, std::size_t>::type>::type>::type;
+
+template <std::size_t N, typename Layout> struct counter_for {
+    using type = std::size_t;
+};
+
+template <std::size_t N> struct counter_for<N, compact> {
+    using type = smallest_counter<N>;
+};
+
+template <std::size_t N> struct counter_for<N, tagged> {
+#if REPEAT_N_CAN_TAG_POINTERS
+    using type = typename std::conditional<N <= UINT16_MAX, tagged_counter, smallest_counter<N>>::type;
+#else
+    using type = smallest_counter<N>;
+#endif
+};
+
+template <> struct counter_for<dynamic_extent, compact> {
+    using type = std::size_t;
+};
+
+template <> struct counter_for<dynamic_extent, tagged> {
+    using type = std::size_t;
+};
+
+template <std::size_t N, typename Layout> using counter_t = typename counter_for<N, Layout>::type;
+
+// An iterator's pointer and count. Counters wrap around like unsigned integers, so stepping outside [0, N] and back
+// again still works, and differences are taken after widening so that they keep their sign.
+template <typename Pointer, typename Counter> class cursor {
+  public:
+    cursor() = default;
+
+    REPEAT_N_CONSTEXPR14 cursor(Pointer l, std::size_t c) noexcept : M_location(l), M_count(static_cast<Counter>(c)) {}
+
+    REPEAT_N_CONSTEXPR14 Pointer location() const noexcept { return M_location; }
+
+    REPEAT_N_CONSTEXPR14 Counter count() const noexcept { return M_count; }
+
+    REPEAT_N_CONSTEXPR14 void advance(std::ptrdiff_t n) noexcept {
+        M_count = static_cast<Counter>(M_count + static_cast<Counter>(n));
+    }
+
+  private:
+    Pointer M_location = nullptr;
+    Counter M_count = 0;
+};
+
+#if REPEAT_N_CAN_TAG_POINTERS
+// not constexpr, converting between pointers and integers is not allowed in constant expressions
+template <typename Pointer> class cursor<Pointer, tagged_counter> {
+    static constexpr unsigned shift = 48;
+    static constexpr std::uintptr_t mask = (std::uintptr_t(1) << shift) - 1;
+
+  public:
+    cursor() = default;
+
+    cursor(Pointer l, std::size_t c) noexcept
+        : M_bits(reinterpret_cast<std::uintptr_t>(l) | (static_cast<std::uintptr_t>(c) << shift)) {
+        assert((reinterpret_cast<std::uintptr_t>(l) & ~mask) == 0 && "tagged needs addresses below 2^48");
+    }
+
+    Pointer location() const noexcept { return reinterpret_cast<Pointer>(M_bits & mask); }
+
+    std::uint16_t count() const noexcept { return static_cast<std::uint16_t>(M_bits >> shift); }
+
+    // carries out of the top bit are discarded, which is the same wrap around as a std::uint16_t
+    void advance(std::ptrdiff_t n) noexcept { M_bits += static_cast<std::uintptr_t>(n) << shift; }
+
+  private:
+    std::uintptr_t M_bits = 0;
+};
+#endif
+} // namespace detail
+} // namespace repeat_n
+
+#endif // REPEAT_N_VIEW_LAYOUT_H
@@ -0,0 +1,83 @@
+/*
+ * Copyright 2021 Chandradeep Dey
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef REPEAT_N_VIEW_MAKE_ARRAY_H
+#define REPEAT_N_VIEW_MAKE_ARRAY_H
+
+#include "config.h"
+#include "extent.h"
+#include "foreign_view.h"
+#include "owned_view.h"
+
+#include <array>
+#include <cstddef>
+#include <utility>
+
+namespace repeat_n {
+namespace detail {
+#if REPEAT_N_CPLUSPLUS >= 201402L
+template <std::size_t... I> using index_sequence = std::index_sequence<I...>;
+
+template <std::size_t N> using make_index_sequence = std::make_index_sequence<N>;
+#else
+template <std::size_t... I> struct index_sequence {};
+
+// joins [0, sizeof...(I)) and [0, sizeof...(J)) into [0, sizeof...(I) + sizeof...(J)), so that N takes log N steps
+template <typename L, typename R> struct concat_indices;
+
+template <std::size_t... I, std::size_t... J> struct concat_indices<index_sequence<I...>, index_sequence<J...>> {
+    using type = index_sequence<I..., (sizeof...(I) + J)...>;
+};
+
+template <std::size_t N> struct make_indices {
+    using type = typename concat_indices<typename make_indices<N / 2>::type,
+                                         typename make_indices<N - N / 2>::type>::type;
+};
+
+template <> struct make_indices<0> {
+    using type = index_sequence<>;
+};
+
+template <> struct make_indices<1> {
+    using type = index_sequence<0>;
+};
+
+template <std::size_t N> using make_index_sequence = typename make_indices<N>::type;
+#endif
+
+template <typename T, std::size_t... I>
+constexpr std::array<T, sizeof...(I)> repeat_array(const T &value, index_sequence<I...>) {
+    return {{(static_cast<void>(I), value)...}};
+}
+} // namespace detail
+
+// A std::array<T, N> holding the view's contents. From C++14 on, when the view is a constant expression so is the
+// result, which lets a table built from a view live in read-only data instead of being filled in at startup:
+//     constexpr auto table = repeat_n::make_array(repeat_n::owned_view<int, 256>(-1));
+template <typename T, std::size_t N, typename Check, typename Layout>
+constexpr std::array<T, N> make_array(const owned_view<T, N, Check, Layout> &view) {
+    static_assert(N != dynamic_extent, "make_array needs a compile-time N");
+    return detail::repeat_array(view.data(), detail::make_index_sequence<N>{});
+}
+
+template <typename T, std::size_t N, typename Check, typename Layout>
+constexpr std::array<T, N> make_array(const foreign_view<T, N, Check, Layout> &view) {
+    static_assert(N != dynamic_extent, "make_array needs a compile-time N");
+    return detail::repeat_array(*view.begin(), detail::make_index_sequence<N>{});
+}
+} // namespace repeat_n
+
+#endif // REPEAT_N_VIEW_MAKE_ARRAY_H
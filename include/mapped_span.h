@@ -0,0 +1,209 @@
+/*
+ * Copyright 2021 Chandradeep Dey
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef REPEAT_N_VIEW_MAPPED_SPAN_H
+#define REPEAT_N_VIEW_MAPPED_SPAN_H
+
+#include "check.h"
+#include "traits.h"
+
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+// memfd_create is in glibc 2.27 and later, and in the other C libraries that define MFD_CLOEXEC
+#if defined(__linux__) && defined(MFD_CLOEXEC)
+#define REPEAT_N_CAN_MAP_PAGES 1
+#else
+#define REPEAT_N_CAN_MAP_PAGES 0
+#endif
+
+namespace repeat_n {
+namespace detail {
+// No more mappings than this per span, well below the usual vm.max_map_count of 65530. Past that the pattern file
+// grows instead, so a span uses at most about size() / 4096 bytes of memory.
+constexpr std::size_t max_span_mappings = 4096;
+
+// The fallback copy, through the aligned operator new when T needs more than the default alignment
+template <typename T> T *allocate_elements(std::size_t n) {
+#ifdef __cpp_aligned_new
+    if (alignof(T) > __STDCPP_DEFAULT_NEW_ALIGNMENT__) {
+        return static_cast<T *>(::operator new(n * sizeof(T), std::align_val_t(alignof(T))));
+    }
+#endif
+    return static_cast<T *>(::operator new(n * sizeof(T)));
+}
+
+template <typename T> void deallocate_elements(T *p) noexcept {
+#ifdef __cpp_aligned_new
+    if (alignof(T) > __STDCPP_DEFAULT_NEW_ALIGNMENT__) {
+        ::operator delete(p, std::align_val_t(alignof(T)));
+        return;
+    }
+#endif
+    ::operator delete(p);
+}
+
+#if REPEAT_N_CAN_MAP_PAGES
+// Maps a file of file_bytes bytes holding the pattern over and over across a reserved range of total bytes, both
+// multiples of the page size. Returns null, having released everything, if any step fails.
+inline void *map_repeated(const unsigned char *value, std::size_t size, std::size_t file_bytes, std::size_t total) {
+    void *base = ::mmap(nullptr, total, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (base == MAP_FAILED) {
+        return nullptr;
+    }
+    const int fd = ::memfd_create("repeat_n", MFD_CLOEXEC);
+    bool mapped = fd >= 0 && ::ftruncate(fd, static_cast<off_t>(file_bytes)) == 0;
+    if (mapped) {
+        void *file = ::mmap(nullptr, file_bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        mapped = file != MAP_FAILED;
+        if (mapped) {
+            auto bytes = static_cast<unsigned char *>(file);
+            for (std::size_t i = 0; i < file_bytes; i += size) {
+                std::memcpy(bytes + i, value, size);
+            }
+            ::munmap(file, file_bytes);
+        }
+    }
+    for (std::size_t offset = 0; mapped && offset < total; offset += file_bytes) {
+        const std::size_t length = offset + file_bytes <= total ? file_bytes : total - offset;
+        void *at = static_cast<unsigned char *>(base) + offset;
+        mapped = ::mmap(at, length, PROT_READ, MAP_SHARED | MAP_FIXED, fd, 0) == at;
+    }
+    // the mappings keep the file alive
+    if (fd >= 0) {
+        ::close(fd);
+    }
+    if (!mapped) {
+        ::munmap(base, total);
+        return nullptr;
+    }
+    return base;
+}
+#endif
+} // namespace detail
+
+// A read-only contiguous array holding the contents of a view of trivially copyable T, for interfaces that want a
+// const T *. Where memfd_create exists and sizeof(T) divides the page size, a small file holding the element over
+// and over is mapped again and again across one reserved address range, so a span of N elements costs one page of
+// memory (more only once it would take over 4096 mappings) and no copying past that page. Otherwise, or if mapping
+// fails, the elements are copied into an ordinary allocation. Move only. Built only from views of one element, see
+// traits.h.
+template <typename T> class mapped_span {
+    static_assert(std::is_trivially_copyable<T>::value, "mapped_span copies the object representation of T");
+#ifndef __cpp_aligned_new
+    static_assert(alignof(T) <= alignof(std::max_align_t), "an over-aligned T needs the aligned operator new of C++17");
+#endif
+
+  public: // types
+    using value_type = T;
+    using size_type = std::size_t;
+    using const_pointer = const T *;
+    using const_iterator = const T *;
+
+  public: // constructors
+    template <typename View, detail::enable_if_repeat_view<View> = true>
+    explicit mapped_span(const View &view) : M_size(view.size()) {
+        static_assert(std::is_same<typename std::remove_cv<typename View::value_type>::type, T>::value,
+                      "mapped_span<T> holds the elements of a view of T");
+        if (M_size == 0) {
+            return;
+        }
+        if (M_size > std::numeric_limits<size_type>::max() / sizeof(T)) {
+#ifndef REPEAT_N_NO_EXCEPTIONS
+            throw std::bad_array_new_length();
+#else
+            std::abort();
+#endif
+        }
+        const T &value = *view.begin();
+#if REPEAT_N_CAN_MAP_PAGES
+        const std::size_t page = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+        if (page % sizeof(T) == 0) {
+            const std::size_t pages = (M_size * sizeof(T) + page - 1) / page;
+            const std::size_t file_pages = (pages + detail::max_span_mappings - 1) / detail::max_span_mappings;
+            M_mapped_bytes = pages * page;
+            M_data = static_cast<const T *>(detail::map_repeated(reinterpret_cast<const unsigned char *>(&value),
+                                                                 sizeof(T), file_pages * page, M_mapped_bytes));
+            if (M_data != nullptr) {
+                return;
+            }
+            M_mapped_bytes = 0;
+        }
+#endif
+        T *copy = detail::allocate_elements<T>(M_size);
+        std::uninitialized_fill_n(copy, M_size, value);
+        M_data = copy;
+    }
+
+    mapped_span(mapped_span &&other) noexcept
+        : M_data(other.M_data), M_size(other.M_size), M_mapped_bytes(other.M_mapped_bytes) {
+        other.M_data = nullptr;
+        other.M_size = 0;
+        other.M_mapped_bytes = 0;
+    }
+
+    mapped_span &operator=(mapped_span &&other) noexcept {
+        std::swap(M_data, other.M_data);
+        std::swap(M_size, other.M_size);
+        std::swap(M_mapped_bytes, other.M_mapped_bytes);
+        return *this;
+    }
+
+    ~mapped_span() {
+#if REPEAT_N_CAN_MAP_PAGES
+        if (M_mapped_bytes != 0) {
+            ::munmap(const_cast<T *>(M_data), M_mapped_bytes);
+            return;
+        }
+#endif
+        detail::deallocate_elements(const_cast<T *>(M_data));
+    }
+
+  public: // access
+    const_pointer data() const noexcept { return M_data; }
+
+    const T &operator[](size_type pos) const noexcept { return M_data[pos]; }
+
+    const_iterator begin() const noexcept { return M_data; }
+
+    const_iterator end() const noexcept { return M_data + M_size; }
+
+    size_type size() const noexcept { return M_size; }
+
+    bool empty() const noexcept { return M_size == 0; }
+
+    // whether the pages are mappings of one small file rather than a copy of every element
+    bool is_mapped() const noexcept { return M_mapped_bytes != 0; }
+
+  private:
+    const T *M_data = nullptr;
+    size_type M_size;
+    size_type M_mapped_bytes = 0;
+};
+} // namespace repeat_n
+
+#endif // REPEAT_N_VIEW_MAPPED_SPAN_H
@@ -0,0 +1,122 @@
+/*
+ * Copyright 2021 Chandradeep Dey
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef REPEAT_N_VIEW_MATERIALIZE_H
+#define REPEAT_N_VIEW_MATERIALIZE_H
+
+#include "chunk.h"
+#include "foreign_view.h"
+#include "owned_view.h"
+#include "traits.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
+namespace repeat_n {
+namespace detail {
+// the first overload that compiles wins, int is preferred over long
+template <typename Container, typename Value>
+auto append_run(Container &c, const Value &value, std::size_t n, int)
+    -> decltype(c.resize(c.size() + n, value), void()) {
+    c.resize(c.size() + n, value);
+}
+
+template <typename Container, typename Value>
+auto append_run(Container &c, const Value &value, std::size_t n, long)
+    -> decltype(c.insert(c.end(), n, value), void()) {
+    c.insert(c.end(), n, value);
+}
+
+template <typename Container, typename Value>
+void append_run(Container &c, const Value &value, std::size_t n, ...) {
+    std::fill_n(std::inserter(c, c.end()), n, value);
+}
+
+template <typename Container, typename Range>
+auto reserve_for(Container &c, const Range &range, int) -> decltype(c.reserve(c.size() + range.size()), void()) {
+    c.reserve(c.size() + range.size());
+}
+
+template <typename Container, typename Range> void reserve_for(Container &, const Range &, long) {}
+
+template <typename Container, typename View>
+auto assign(Container &c, const View &view, int) ->
+    typename std::enable_if<is_repeat_view<View>::value, decltype(c.assign(view.size(), *view.begin()))>::type {
+    if (view.size() == 0) {
+        c.clear();
+    } else {
+        c.assign(view.size(), *view.begin());
+    }
+}
+
+template <typename Container, typename Range> void assign(Container &c, const Range &range, long);
+
+template <typename Container, typename View>
+auto construct(const View &view, int) ->
+    typename std::enable_if<is_repeat_view<View>::value, decltype(Container(view.size(), *view.begin()))>::type {
+    return view.size() == 0 ? Container() : Container(view.size(), *view.begin());
+}
+
+template <typename Container, typename Range> Container construct(const Range &range, long);
+
+template <typename Container> struct run_appender {
+    template <typename Value> void operator()(const Value &value, std::size_t n) {
+        detail::append_run(c, value, n, 0);
+    }
+
+    Container &c;
+};
+} // namespace detail
+
+// Appends range to c with a single reserve, when the container has one, followed by one count-based
+// resize(size() + n, value) or insert(end(), n, value) per chunk (see chunk.h). Containers with neither are filled
+// through an inserter.
+template <typename Container, typename Range> Container &append_to(Container &c, const Range &range) {
+    detail::reserve_for(c, range, 0);
+    for_each_chunk(range, detail::run_appender<Container>{c});
+    return c;
+}
+
+// c.assign(n, value) for a repeat view, otherwise clear() and append_to
+template <typename Container, typename Range> Container &assign_to(Container &c, const Range &range) {
+    detail::assign(c, range, 0);
+    return c;
+}
+
+// Container(n, value) for a repeat view, which covers std::basic_string(n, ch), otherwise append_to on an empty
+// Container. Either way a std::vector or std::basic_string is allocated exactly once.
+template <typename Container, typename Range> Container to(const Range &range) {
+    return detail::construct<Container>(range, 0);
+}
+
+namespace detail {
+template <typename Container, typename Range> void assign(Container &c, const Range &range, long) {
+    c.clear();
+    append_to(c, range);
+}
+
+template <typename Container, typename Range> Container construct(const Range &range, long) {
+    Container c;
+    append_to(c, range);
+    return c;
+}
+} // namespace detail
+} // namespace repeat_n
+
+#endif // REPEAT_N_VIEW_MATERIALIZE_H
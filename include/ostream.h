@@ -0,0 +1,112 @@
+/*
+ * Copyright 2021 Chandradeep Dey
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef REPEAT_N_VIEW_OSTREAM_H
+#define REPEAT_N_VIEW_OSTREAM_H
+
+#include "foreign_view.h"
+#include "owned_view.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <ios>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <type_traits>
+
+namespace repeat_n {
+namespace detail {
+// the staging block stops doubling once it holds this many characters
+constexpr std::size_t ostream_block_chars = 4096;
+
+// n copies of block through sputn, after doubling it to as many copies as fit in ostream_block_chars
+template <typename CharT, typename Traits>
+void put_repeated(std::basic_ostream<CharT, Traits> &os, std::basic_string<CharT, Traits> block, std::size_t n) {
+    const std::size_t length = block.size();
+    std::size_t copies = 1;
+    while (copies * 2 <= n && block.size() * 2 <= ostream_block_chars) {
+        block += block;
+        copies *= 2;
+    }
+    for (std::size_t left = n; left != 0;) {
+        const std::size_t now = std::min(left, copies);
+        const auto chars = static_cast<std::streamsize>(now * length);
+        if (os.rdbuf()->sputn(block.data(), chars) != chars) {
+            os.setstate(std::ios_base::badbit);
+            return;
+        }
+        left -= now;
+    }
+}
+
+// the stream's own character type needs no formatting
+template <typename CharT, typename Traits>
+std::basic_string<CharT, Traits> render(const std::basic_ostream<CharT, Traits> &, const CharT &value) {
+    return std::basic_string<CharT, Traits>(1, value);
+}
+
+// formatted the way os would format it, less the width, which only ever applies to the first element
+template <typename CharT, typename Traits, typename T>
+std::basic_string<CharT, Traits> render(const std::basic_ostream<CharT, Traits> &os, const T &value) {
+    std::basic_ostringstream<CharT, Traits> out;
+    out.flags(os.flags());
+    out.precision(os.precision());
+    out.fill(os.fill());
+    out.imbue(os.getloc());
+    out << value;
+    return out.str();
+}
+
+template <typename CharT, typename Traits, typename T>
+std::basic_ostream<CharT, Traits> &insert_repeated(std::basic_ostream<CharT, Traits> &os, const T &value,
+                                                   std::size_t n) {
+    if (n == 0) {
+        return os;
+    }
+    os << value;
+    if (n == 1 || !os) {
+        return os;
+    }
+    const typename std::basic_ostream<CharT, Traits>::sentry sentry(os);
+    if (sentry) {
+        std::basic_string<CharT, Traits> rendered = detail::render(os, value);
+        if (!rendered.empty()) {
+            detail::put_repeated(os, std::move(rendered), n - 1);
+        }
+    }
+    return os;
+}
+} // namespace detail
+
+// The same output as std::copy to a std::ostream_iterator without a delimiter, with the width applying to the first
+// element only. The first element goes through the element's own operator<<. The rest are formatted once into a
+// string, or taken as they are when the element is the stream's character type, and written in blocks of up to 4096
+// characters through the streambuf's sputn.
+template <typename CharT, typename Traits, typename T, std::size_t N, typename Check, typename Layout>
+std::basic_ostream<CharT, Traits> &operator<<(std::basic_ostream<CharT, Traits> &os,
+                                             const owned_view<T, N, Check, Layout> &view) {
+    return detail::insert_repeated(os, view.data(), view.size());
+}
+
+template <typename CharT, typename Traits, typename T, std::size_t N, typename Check, typename Layout>
+std::basic_ostream<CharT, Traits> &operator<<(std::basic_ostream<CharT, Traits> &os,
+                                             const foreign_view<T, N, Check, Layout> &view) {
+    return view.size() == 0 ? os : detail::insert_repeated(os, *view.begin(), view.size());
+}
+} // namespace repeat_n
+
+#endif // REPEAT_N_VIEW_OSTREAM_H
@@ -17,183 +17,312 @@
 #ifndef REPEAT_N_VIEW_OWNED_VIEW_H
 #define REPEAT_N_VIEW_OWNED_VIEW_H
 
+#include "check.h"
+#include "config.h"
+#include "extent.h"
+#include "instrument.h"
+#include "foreign_view.h"
+#include "layout.h"
+#include "sentinel.h"
+
+#include <algorithm>
 #include <cstddef>
 #include <iterator>
 #include <limits>
-#include <stdexcept>
+#include <memory>
 #include <type_traits>
 #include <utility>
 
 namespace repeat_n {
-template <typename T, std::size_t N = 1> class owned_view {
-  public: // types
+template <typename T, std::size_t N, typename Check, typename Layout> class owned_view;
+template <typename T, std::size_t N, typename Allocator, typename Check, typename Layout> class allocated_view;
+
+// Shared by every owned_view<T, N> whose N needs the same Counter, so that each count does not instantiate its own
+// iterators. See layout.h for the possible Counters.
+template <typename T, bool mutability, typename Check = default_check, typename Counter = std::size_t>
+class owned_view_iterator {
+    // Iterator
+  public:
     using value_type = T;
-    using size_type = std::size_t;
     using difference_type = std::ptrdiff_t;
-    using reference = typename std::add_lvalue_reference<T>::type;
-    using const_reference = typename std::add_lvalue_reference<typename std::add_const<T>::type>::type;
-    using pointer = typename std::add_pointer<T>::type;
-    using const_pointer = typename std::add_pointer<typename std::add_const<T>::type>::type;
-
-  private: // handle iterator and const_iterator as a single template
-    template <bool mutability> class _iterator_templ {
-        // Iterator
-      public:
-        using value_type = owned_view::value_type;
-        using difference_type = owned_view::difference_type;
-        using reference =
-            typename std::conditional<mutability, owned_view::reference, owned_view::const_reference>::type;
-        using pointer = typename std::conditional<mutability, owned_view::pointer, owned_view::const_pointer>::type;
-        using iterator_category = std::random_access_iterator_tag;
-
-      public:
-        _iterator_templ(const _iterator_templ &other) = default;
-
-        _iterator_templ &operator=(const _iterator_templ &other) = default;
-
-        friend void swap(_iterator_templ &lhs, _iterator_templ &rhs) {
-            auto temp = lhs;
-            lhs = rhs;
-            rhs = temp;
+    using reference = typename std::conditional<mutability, typename std::add_lvalue_reference<T>::type,
+                                                typename std::add_lvalue_reference<const T>::type>::type;
+    using pointer = typename std::conditional<mutability, typename std::add_pointer<T>::type,
+                                              typename std::add_pointer<const T>::type>::type;
+    using iterator_category = std::random_access_iterator_tag;
+
+  public:
+    owned_view_iterator(const owned_view_iterator &other) = default;
+
+    owned_view_iterator &operator=(const owned_view_iterator &other) = default;
+
+    friend REPEAT_N_CONSTEXPR14 void swap(owned_view_iterator &lhs, owned_view_iterator &rhs) {
+        auto temp = lhs;
+        lhs = rhs;
+        rhs = temp;
+    }
+
+    REPEAT_N_CONSTEXPR14 reference operator*() const {
+        REPEAT_N_COUNT(owned_view_iterator, dereference);
+        return *position.location();
+    }
+
+    REPEAT_N_CONSTEXPR14 owned_view_iterator &operator++() {
+        REPEAT_N_COUNT(owned_view_iterator, increment);
+        position.advance(1);
+        return *this;
+    }
+
+    // InputIterator
+    friend REPEAT_N_CONSTEXPR14 bool operator==(const owned_view_iterator &lhs, const owned_view_iterator &rhs) {
+        REPEAT_N_COUNT_IF(lhs.position.location() != rhs.position.location(), owned_view_iterator,
+                          cross_view_comparison);
+        Check::same_view(lhs.position.location(), rhs.position.location(),
+                         "Requested comparison between different views");
+        return lhs.position.count() == rhs.position.count();
+    }
+
+    friend REPEAT_N_CONSTEXPR14 bool operator!=(const owned_view_iterator &lhs, const owned_view_iterator &rhs) {
+        return !(lhs == rhs);
+    }
+
+    REPEAT_N_CONSTEXPR14 pointer operator->() const { return &operator*(); }
+
+    REPEAT_N_CONSTEXPR14 owned_view_iterator operator++(int) & {
+        auto prev = *this;
+        ++*this;
+        return prev;
+    }
+
+    // ForwardIterator
+    owned_view_iterator() = default;
+
+    // BidirectionalIterator
+    REPEAT_N_CONSTEXPR14 owned_view_iterator &operator--() {
+        REPEAT_N_COUNT(owned_view_iterator, decrement);
+        position.advance(-1);
+        return *this;
+    }
+
+    REPEAT_N_CONSTEXPR14 owned_view_iterator operator--(int) & {
+        auto prev = *this;
+        --*this;
+        return prev;
+    }
+
+    // RandomAccessIterator
+    REPEAT_N_CONSTEXPR14 owned_view_iterator &operator+=(difference_type n) {
+        REPEAT_N_COUNT(owned_view_iterator, jump);
+        position.advance(n);
+        return *this;
+    }
+
+    friend REPEAT_N_CONSTEXPR14 owned_view_iterator operator+(owned_view_iterator a, difference_type n) {
+        return a += n;
+    }
+
+    friend REPEAT_N_CONSTEXPR14 owned_view_iterator operator+(difference_type n, owned_view_iterator a) {
+        return a + n;
+    }
+
+    REPEAT_N_CONSTEXPR14 owned_view_iterator &operator-=(difference_type n) { return operator+=(-n); }
+
+    friend REPEAT_N_CONSTEXPR14 owned_view_iterator operator-(owned_view_iterator a, difference_type n) {
+        return a -= n;
+    }
+
+    friend REPEAT_N_CONSTEXPR14 difference_type operator-(const owned_view_iterator &a, const owned_view_iterator &b) {
+        REPEAT_N_COUNT_IF(a.position.location() != b.position.location(), owned_view_iterator,
+                          cross_view_comparison);
+        Check::same_view(a.position.location(), b.position.location(), "Requested difference between different views");
+        // widened first, an unsigned counter would otherwise wrap instead of going negative
+        return static_cast<difference_type>(a.position.count()) - static_cast<difference_type>(b.position.count());
+    }
+
+    // every element is the same object
+    REPEAT_N_CONSTEXPR14 reference operator[](difference_type) const {
+        REPEAT_N_COUNT(owned_view_iterator, dereference);
+        return *position.location();
+    }
+
+    friend REPEAT_N_CONSTEXPR14 bool operator<(const owned_view_iterator &a, const owned_view_iterator &b) {
+        REPEAT_N_COUNT_IF(a.position.location() != b.position.location(), owned_view_iterator,
+                          cross_view_comparison);
+        Check::same_view(a.position.location(), b.position.location(), "Requested comparison between different views");
+        return a.position.count() < b.position.count();
+    }
+
+    friend REPEAT_N_CONSTEXPR14 bool operator<=(const owned_view_iterator &a, const owned_view_iterator &b) {
+        REPEAT_N_COUNT_IF(a.position.location() != b.position.location(), owned_view_iterator,
+                          cross_view_comparison);
+        Check::same_view(a.position.location(), b.position.location(), "Requested comparison between different views");
+        return a.position.count() <= b.position.count();
+    }
+
+    friend REPEAT_N_CONSTEXPR14 bool operator>(const owned_view_iterator &a, const owned_view_iterator &b) {
+        return !(a <= b);
+    }
+
+    friend REPEAT_N_CONSTEXPR14 bool operator>=(const owned_view_iterator &a, const owned_view_iterator &b) {
+        return !(a < b);
+    }
+
+  public: // the end as a counted_sentinel, see sentinel.h
+    friend REPEAT_N_CONSTEXPR14 bool operator==(const owned_view_iterator &it, counted_sentinel s) noexcept {
+        return static_cast<std::size_t>(it.position.count()) == s.count;
+    }
+
+    friend REPEAT_N_CONSTEXPR14 bool operator==(counted_sentinel s, const owned_view_iterator &it) noexcept {
+        return it == s;
+    }
+
+    friend REPEAT_N_CONSTEXPR14 bool operator!=(const owned_view_iterator &it, counted_sentinel s) noexcept {
+        return !(it == s);
+    }
+
+    friend REPEAT_N_CONSTEXPR14 bool operator!=(counted_sentinel s, const owned_view_iterator &it) noexcept {
+        return !(it == s);
+    }
+
+    friend REPEAT_N_CONSTEXPR14 difference_type operator-(counted_sentinel s, const owned_view_iterator &it) noexcept {
+        return static_cast<difference_type>(s.count) - static_cast<difference_type>(it.position.count());
+    }
+
+    friend REPEAT_N_CONSTEXPR14 difference_type operator-(const owned_view_iterator &it, counted_sentinel s) noexcept {
+        return -(s - it);
+    }
+
+  public: // segmented iteration, see chunk.h
+    template <typename F> void for_each_chunk(const owned_view_iterator &last, F &&f) const {
+        auto n = last - *this;
+        if (n > 0) {
+            f(*position.location(), static_cast<std::size_t>(n));
         }
+    }
 
-        reference operator*() const { return *location; }
+  public: // conversion from iterator to const_iterator
+    template <bool B, typename std::enable_if<B, bool>::type = true>
+    REPEAT_N_CONSTEXPR14 owned_view_iterator(const owned_view_iterator<T, B, Check, Counter> &other)
+        : position(other.position.location(), other.position.count()) {}
 
-        _iterator_templ &operator++() {
-            ++curr;
-            return *this;
-        }
-
-        // InputIterator
-        friend bool operator==(const _iterator_templ &lhs, const _iterator_templ &rhs) {
-            return lhs.location == rhs.location && lhs.curr == rhs.curr;
-        }
+    template <bool B, typename std::enable_if<B, bool>::type = true>
+    REPEAT_N_CONSTEXPR14 owned_view_iterator &operator=(const owned_view_iterator<T, B, Check, Counter> &other) {
+        position = decltype(position)(other.position.location(), other.position.count());
+        return *this;
+    }
 
-        friend bool operator!=(const _iterator_templ &lhs, const _iterator_templ &rhs) { return !(lhs == rhs); }
-
-        pointer operator->() const { return &operator*(); }
-
-        _iterator_templ operator++(int) & {
-            auto prev = *this;
-            ++*this;
-            return prev;
-        }
+  private: // constructor only owned_view and allocated_view can access
+    template <typename, std::size_t, typename, typename> friend class owned_view;
+    template <typename, std::size_t, typename, typename, typename> friend class allocated_view;
+    friend class owned_view_iterator<T, !mutability, Check, Counter>;
 
-        // ForwardIterator
-        _iterator_templ() = default;
-
-        // BidirectionalIterator
-        _iterator_templ &operator--() {
-            --curr;
-            return *this;
-        }
-
-        _iterator_templ operator--(int) & {
-            auto prev = *this;
-            --*this;
-            return prev;
-        }
-
-        // RandomAccessIterator
-        _iterator_templ &operator+=(difference_type n) {
-            curr += n;
-            return *this;
-        }
-
-        friend _iterator_templ operator+(_iterator_templ a, difference_type n) { return a += n; }
-
-        friend _iterator_templ operator+(difference_type n, _iterator_templ a) { return a + n; }
-
-        _iterator_templ &operator-=(difference_type n) { return operator+=(-n); }
-
-        friend _iterator_templ operator-(_iterator_templ a, difference_type n) { return a -= n; }
-
-        friend difference_type operator-(const _iterator_templ &a, const _iterator_templ &b) {
-            return a.location == b.location ? a.curr - b.curr : 0;
-        }
+    REPEAT_N_CONSTEXPR14 owned_view_iterator(pointer l, std::size_t c) : position(l, c) {}
 
-        reference operator[](difference_type n) { return *(location + n); }
-
-        friend bool operator<(const _iterator_templ &a, const _iterator_templ &b) {
-            return a.location == b.location && a.curr < b.curr;
-        }
-
-        friend bool operator<=(const _iterator_templ &a, const _iterator_templ &b) {
-            return a.location == b.location && a.curr <= b.curr;
-        }
-
-        friend bool operator>(const _iterator_templ &a, const _iterator_templ &b) { return !(a <= b); }
-
-        friend bool operator>=(const _iterator_templ &a, const _iterator_templ &b) { return !(a < b); }
-
-      public: // conversion from iterator to const_iterator
-        template <bool B, typename std::enable_if<B, bool>::type = true>
-        _iterator_templ(const _iterator_templ<B> &other) : location(other.location), curr(other.curr) {}
-
-        template <bool B, typename std::enable_if<B, bool>::type = true>
-        _iterator_templ &operator=(const _iterator_templ<B> &other) {
-            location = other.location;
-            curr = other.curr;
-            return *this;
-        }
-
-      private: // constructor only owned_view can access
-        friend class owned_view;
-
-        _iterator_templ(pointer l, std::size_t c) : location(l), curr(c) {}
-
-      private: // data members
-        pointer location = nullptr;
-        std::size_t curr = 0;
-    };
+  private: // data members
+    detail::cursor<pointer, Counter> position;
+};
 
-  public: // types continued
-    using iterator = _iterator_templ<true>;
-    using const_iterator = _iterator_templ<false>;
+template <typename T, std::size_t N = 1, typename Check = default_check, typename Layout = plain>
+class owned_view : private detail::extent<N> {
+  public: // types
+    using value_type = T;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using reference = typename std::add_lvalue_reference<T>::type;
+    using const_reference = typename std::add_lvalue_reference<typename std::add_const<T>::type>::type;
+    using pointer = typename std::add_pointer<T>::type;
+    using const_pointer = typename std::add_pointer<typename std::add_const<T>::type>::type;
+    using iterator = owned_view_iterator<T, true, Check, detail::counter_t<N, Layout>>;
+    using const_iterator = owned_view_iterator<T, false, Check, detail::counter_t<N, Layout>>;
     using reverse_iterator = std::reverse_iterator<iterator>;
     using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+    using subview_type = foreign_view<T, dynamic_extent, Check, Layout>;
 
   public: // constructors
-    template <typename... Args> explicit owned_view(Args &&...args) : M_contents(std::forward<Args>(args)...) {}
+    template <typename... Args, std::size_t M = N, typename std::enable_if<M != dynamic_extent, bool>::type = true>
+    REPEAT_N_CONSTEXPR14 explicit owned_view(Args &&...args) : M_contents(std::forward<Args>(args)...) {
+        REPEAT_N_COUNT(owned_view, view_constructed);
+    }
+
+    // same argument order as the (size_type, value_type) constructors of the STL containers
+    template <typename... Args, std::size_t M = N, typename std::enable_if<M == dynamic_extent, bool>::type = true>
+    REPEAT_N_CONSTEXPR14 explicit owned_view(size_type n, Args &&...args)
+        : detail::extent<N>(n), M_contents(std::forward<Args>(args)...) {
+        REPEAT_N_COUNT(owned_view, view_constructed);
+    }
 
   public: // access contents directly
-    reference data() noexcept { return M_contents; }
+    REPEAT_N_CONSTEXPR14 reference data() noexcept { return M_contents; }
 
-    const_reference data() const noexcept { return M_contents; }
+    REPEAT_N_CONSTEXPR14 const_reference data() const noexcept { return M_contents; }
 
   public: // iterators
-    iterator begin() noexcept { return iterator(std::addressof(M_contents), 0); }
+    REPEAT_N_CONSTEXPR14 iterator begin() noexcept { return iterator(detail::addressof(M_contents), 0); }
 
-    const_iterator begin() const noexcept { return const_iterator(std::addressof(M_contents), 0); }
+    REPEAT_N_CONSTEXPR14 const_iterator begin() const noexcept {
+        return const_iterator(detail::addressof(M_contents), 0);
+    }
 
-    const_iterator cbegin() const noexcept { return const_iterator(std::addressof(M_contents), 0); }
+    REPEAT_N_CONSTEXPR14 const_iterator cbegin() const noexcept {
+        return const_iterator(detail::addressof(M_contents), 0);
+    }
 
-    iterator end() noexcept { return iterator(std::addressof(M_contents), N); }
+    REPEAT_N_CONSTEXPR14 iterator end() noexcept { return iterator(detail::addressof(M_contents), size()); }
 
-    const_iterator end() const noexcept { return const_iterator(std::addressof(M_contents), N); }
+    REPEAT_N_CONSTEXPR14 const_iterator end() const noexcept {
+        return const_iterator(detail::addressof(M_contents), size());
+    }
 
-    const_iterator cend() const noexcept { return const_iterator(std::addressof(M_contents), N); }
+    REPEAT_N_CONSTEXPR14 const_iterator cend() const noexcept {
+        return const_iterator(detail::addressof(M_contents), size());
+    }
 
-    reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+    REPEAT_N_CONSTEXPR17 reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
 
-    const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(end()); }
+    REPEAT_N_CONSTEXPR17 const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(end()); }
 
-    const_reverse_iterator crbegin() const noexcept { return const_reverse_iterator(cend()); }
+    REPEAT_N_CONSTEXPR17 const_reverse_iterator crbegin() const noexcept { return const_reverse_iterator(cend()); }
 
-    reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
+    REPEAT_N_CONSTEXPR17 reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
 
-    const_reverse_iterator rend() const noexcept { return const_reverse_iterator(begin()); }
+    REPEAT_N_CONSTEXPR17 const_reverse_iterator rend() const noexcept { return const_reverse_iterator(begin()); }
 
-    const_reverse_iterator crend() const noexcept { return const_reverse_iterator(cbegin()); }
+    REPEAT_N_CONSTEXPR17 const_reverse_iterator crend() const noexcept { return const_reverse_iterator(cbegin()); }
 
   public: // capacity
-    size_type size() const noexcept { return N; }
+    REPEAT_N_CONSTEXPR14 size_type size() const noexcept { return this->M_extent(); }
 
-    difference_type max_size() const noexcept { return std::numeric_limits<difference_type>::max(); }
+    REPEAT_N_CONSTEXPR14 difference_type max_size() const noexcept {
+        return std::numeric_limits<difference_type>::max();
+    }
+
+  public: // sub-ranges in O(1), foreign views of this view's element that must not outlive it
+    // like std::basic_string_view::substr, count is clamped to what is left after pos
+    REPEAT_N_CONSTEXPR14 subview_type subview(size_type pos, size_type count = dynamic_extent) const noexcept {
+        return subview_type(std::min(count, size() - std::min(pos, size())), detail::addressof(M_contents));
+    }
+
+    // the first half gets the smaller share of an odd size
+    REPEAT_N_CONSTEXPR14 std::pair<subview_type, subview_type> split() const noexcept {
+        return std::make_pair(subview(0, size() / 2), subview(size() / 2));
+    }
 
   private:
     T M_contents;
 };
 } // namespace repeat_n
 
+#if REPEAT_N_HAS_RANGES
+#include <ranges>
+
+// Copying an owned_view copies one element, which is what std::ranges::view asks for, like std::ranges::single_view.
+// It is not a borrowed_range, its iterators point into it.
+namespace std {
+namespace ranges {
+template <typename T, std::size_t N, typename Check, typename Layout>
+inline constexpr bool enable_view<repeat_n::owned_view<T, N, Check, Layout>> = true;
+} // namespace ranges
+} // namespace std
+#endif
+
 #endif // REPEAT_N_VIEW_OWNED_VIEW_H
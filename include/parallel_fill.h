@@ -0,0 +1,128 @@
+/*
+ * Copyright 2021 Chandradeep Dey
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef REPEAT_N_VIEW_PARALLEL_FILL_H
+#define REPEAT_N_VIEW_PARALLEL_FILL_H
+
+#include "check.h"
+#include "fill_into.h"
+#include "traits.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <system_error>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace repeat_n {
+namespace detail {
+inline std::size_t page_size() noexcept {
+#if defined(_SC_PAGESIZE)
+    static const long page = sysconf(_SC_PAGESIZE);
+    if (page > 0) {
+        return static_cast<std::size_t>(page);
+    }
+#endif
+    return 4096;
+}
+
+// below this many bytes per thread starting the thread costs more than the stores it takes over
+constexpr std::size_t parallel_fill_grain = std::size_t(1) << 20;
+
+template <typename T> void fill_chunk(const T &value, std::size_t n, T *dest, store_mode mode, std::true_type) {
+    detail::broadcast_fill(value, n, dest, mode);
+}
+
+template <typename T> void fill_chunk(const T &value, std::size_t n, T *dest, store_mode, std::false_type) {
+    std::fill_n(dest, n, value);
+}
+
+// Joins every thread still joinable when it goes out of scope, so that an exception on the calling thread never
+// destroys a joinable std::thread, which would call std::terminate.
+struct join_all {
+    std::vector<std::thread> &threads;
+
+    ~join_all() {
+        for (auto &thread : threads) {
+            if (thread.joinable()) {
+                thread.join();
+            }
+        }
+    }
+};
+
+// The index of the first element at or after the page boundary that follows element i, so that no page is written
+// by two threads. Capped at n.
+template <typename T> std::size_t page_boundary(const T *dest, std::size_t i, std::size_t n) noexcept {
+    const std::uintptr_t base = reinterpret_cast<std::uintptr_t>(dest);
+    const std::uintptr_t page = page_size();
+    const std::uintptr_t boundary = (base + i * sizeof(T) + page - 1) / page * page;
+    return std::min(n, static_cast<std::size_t>((boundary - base + sizeof(T) - 1) / sizeof(T)));
+}
+} // namespace detail
+
+// Writes view.size() copies of the view's element starting at dest, like fill_into, split across threads (0 means
+// std::thread::hardware_concurrency()). Every thread gets a contiguous run of whole pages, so when dest is freshly
+// allocated and untouched the operating system's first touch policy places each page on the NUMA node of the thread
+// that fills it. Each run goes through the same broadcast stores as fill_into. Threads are only started for runs of at
+// least a megabyte, the calling thread fills the last run itself, and everything is joined before returning. If a
+// thread cannot be started the calling thread fills its run and the ones after it too. Programs using this need to link
+// with the platform's thread library (Threads::Threads in CMake). Only for views of one element, see traits.h.
+template <typename View, typename T, detail::enable_if_repeat_view<View> = true>
+T *parallel_fill(const View &view, T *dest, unsigned threads = 0, store_mode mode = store_mode::automatic) {
+    static_assert(std::is_same<typename View::value_type, T>::value, "dest must point to the view's value_type");
+    const std::size_t n = view.size();
+    if (n == 0) {
+        return dest;
+    }
+    if (threads == 0) {
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    const std::size_t useful = std::max<std::size_t>(1, n * sizeof(T) / detail::parallel_fill_grain);
+    const std::size_t parts = std::min<std::size_t>(threads, useful);
+
+    const T &value = *view.begin();
+    const detail::is_broadcastable<T> simd_path{};
+    std::vector<std::thread> workers;
+    workers.reserve(parts - 1);
+    const detail::join_all joiner{workers};
+    std::size_t first = 0;
+    for (std::size_t p = 1; p < parts; ++p) {
+        const std::size_t last = detail::page_boundary(dest, n / parts * p, n);
+        if (last > first) {
+#ifndef REPEAT_N_NO_EXCEPTIONS
+            try {
+                workers.emplace_back(
+                    [=, &value] { detail::fill_chunk(value, last - first, dest + first, mode, simd_path); });
+            } catch (const std::system_error &) {
+                // no more threads to be had, so the calling thread fills everything not handed out yet
+                break;
+            }
+#else
+            workers.emplace_back(
+                [=, &value] { detail::fill_chunk(value, last - first, dest + first, mode, simd_path); });
+#endif
+            first = last;
+        }
+    }
+    detail::fill_chunk(value, n - first, dest + first, mode, simd_path);
+    return dest + n;
+}
+} // namespace repeat_n
+
+#endif // REPEAT_N_VIEW_PARALLEL_FILL_H
@@ -0,0 +1,174 @@
+/*
+ * Copyright 2021 Chandradeep Dey
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef REPEAT_N_VIEW_PARALLEL_FOR_EACH_H
+#define REPEAT_N_VIEW_PARALLEL_FOR_EACH_H
+
+#include "check.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+namespace repeat_n {
+namespace detail {
+// a sub-range of the view together with the index of its first element in the view
+template <typename Subview> struct indexed_range {
+    std::size_t offset;
+    Subview range;
+};
+
+// One per thread. The owner pushes and pops at the back, so it keeps working on the most recently split and most
+// cache friendly range, while thieves take from the front, where the largest ranges are.
+template <typename Range> class work_deque {
+  public:
+    void push(const Range &r) {
+        std::lock_guard<std::mutex> lock(M_mutex);
+        M_ranges.push_back(r);
+    }
+
+    bool pop(Range &r) {
+        std::lock_guard<std::mutex> lock(M_mutex);
+        if (M_ranges.empty()) {
+            return false;
+        }
+        r = M_ranges.back();
+        M_ranges.pop_back();
+        return true;
+    }
+
+    bool steal(Range &r) {
+        std::lock_guard<std::mutex> lock(M_mutex);
+        if (M_ranges.empty()) {
+            return false;
+        }
+        r = M_ranges.front();
+        M_ranges.pop_front();
+        return true;
+    }
+
+  private:
+    std::mutex M_mutex;
+    std::deque<Range> M_ranges;
+};
+} // namespace detail
+
+// Calls f(i, value) for every index i of view, where value is the view's element, on up to threads threads (0 means
+// std::thread::hardware_concurrency()). The index is passed because it is the only thing that differs between
+// elements. Each thread starts with an equal share and keeps splitting its current range in half with split(),
+// leaving the upper half where idle threads can steal it, until ranges are down to grain elements (0 picks one that
+// gives every thread about 64 ranges). So work that gets more expensive towards one end still balances. When f throws,
+// the other threads stop after their current range, and once every thread is joined the first exception is rethrown.
+// A thread that cannot be started leaves its share to the others. Link with Threads::Threads.
+template <typename View, typename F>
+void parallel_for_each(const View &view, F f, unsigned threads = 0, std::size_t grain = 0) {
+    using range = detail::indexed_range<typename View::subview_type>;
+    const std::size_t n = view.size();
+    if (n == 0) {
+        return;
+    }
+    if (threads == 0) {
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    const std::size_t parts = std::min<std::size_t>(threads, n);
+    if (grain == 0) {
+        grain = std::max<std::size_t>(1, n / (parts * 64));
+    }
+
+    std::vector<detail::work_deque<range>> deques(parts);
+    for (std::size_t p = 0; p < parts; ++p) {
+        const std::size_t first = n / parts * p + std::min(p, n % parts);
+        deques[p].push(range{first, view.subview(first, n / parts + (p < n % parts))});
+    }
+
+    std::atomic<std::size_t> remaining(n);
+    std::atomic<bool> failed(false);
+    const auto &value = *view.begin();
+    auto work = [&](std::size_t self) {
+        range r{0, view.subview(0, 0)};
+        while (remaining.load(std::memory_order_acquire) != 0 && !failed.load(std::memory_order_acquire)) {
+            bool found = deques[self].pop(r);
+            for (std::size_t k = 1; !found && k < parts; ++k) {
+                found = deques[(self + k) % parts].steal(r);
+            }
+            if (!found) {
+                std::this_thread::yield();
+                continue;
+            }
+            while (r.range.size() > grain) {
+                auto halves = r.range.split();
+                deques[self].push(range{r.offset + halves.first.size(), halves.second});
+                r.range = halves.first;
+            }
+            for (std::size_t i = 0; i < r.range.size(); ++i) {
+                f(r.offset + i, value);
+            }
+            remaining.fetch_sub(r.range.size(), std::memory_order_acq_rel);
+        }
+    };
+
+#ifndef REPEAT_N_NO_EXCEPTIONS
+    // an exception leaving a thread would call std::terminate, so each one is caught and the first kept
+    std::exception_ptr error;
+    std::mutex error_mutex;
+    auto run = [&](std::size_t self) {
+        try {
+            work(self);
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(error_mutex);
+            if (!error) {
+                error = std::current_exception();
+            }
+            failed.store(true, std::memory_order_release);
+        }
+    };
+#else
+    auto &run = work;
+#endif
+
+    std::vector<std::thread> workers;
+    workers.reserve(parts - 1);
+    for (std::size_t p = 1; p < parts; ++p) {
+#ifndef REPEAT_N_NO_EXCEPTIONS
+        try {
+            workers.emplace_back(run, p);
+        } catch (const std::system_error &) {
+            // the deques of threads that never started are stolen from like any other
+            break;
+        }
+#else
+        workers.emplace_back(run, p);
+#endif
+    }
+    run(0);
+    for (auto &worker : workers) {
+        worker.join();
+    }
+#ifndef REPEAT_N_NO_EXCEPTIONS
+    if (error) {
+        std::rethrow_exception(error);
+    }
+#endif
+}
+} // namespace repeat_n
+
+#endif // REPEAT_N_VIEW_PARALLEL_FOR_EACH_H
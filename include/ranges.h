@@ -0,0 +1,85 @@
+/*
+ * Copyright 2021 Chandradeep Dey
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef REPEAT_N_VIEW_RANGES_H
+#define REPEAT_N_VIEW_RANGES_H
+
+#include "config.h"
+#include "owned_view.h"
+#include "sentinel.h"
+
+// C++20 only, with the C++11 headers this one includes nothing else
+#if REPEAT_N_HAS_RANGES
+#include <cstddef>
+#include <ranges>
+#include <type_traits>
+#include <utility>
+
+namespace repeat_n {
+// What views::repeat_n gives: an owned_view of runtime size whose end() is a counted_sentinel rather than an iterator,
+// so loops and the std::ranges algorithms stop on one integer comparison. size() is O(1) as always.
+template <typename T, typename Check = default_check>
+class repeat_n_range : public std::ranges::view_interface<repeat_n_range<T, Check>> {
+  public: // types
+    using view_type = owned_view<T, dynamic_extent, Check>;
+
+  public: // constructors
+    constexpr repeat_n_range(T value, std::size_t n) : M_view(n, std::move(value)) {}
+
+  public: // range
+    constexpr typename view_type::iterator begin() noexcept { return M_view.begin(); }
+
+    constexpr typename view_type::const_iterator begin() const noexcept { return M_view.begin(); }
+
+    constexpr counted_sentinel end() const noexcept { return counted_sentinel(M_view.size()); }
+
+    constexpr std::size_t size() const noexcept { return M_view.size(); }
+
+    // the same elements with an iterator for end(), for the algorithms outside std::ranges
+    constexpr const view_type &base() const noexcept { return M_view; }
+
+  private:
+    view_type M_view;
+};
+
+namespace detail {
+// views::repeat_n(n) waiting for the value on the left of a |
+struct repeat_n_closure {
+    std::size_t n;
+
+    template <typename T>
+    friend constexpr repeat_n_range<std::decay_t<T>> operator|(T &&value, const repeat_n_closure &closure) {
+        return repeat_n_range<std::decay_t<T>>(std::forward<T>(value), closure.n);
+    }
+};
+
+struct repeat_n_adaptor {
+    template <typename T> constexpr repeat_n_range<std::decay_t<T>> operator()(T &&value, std::size_t n) const {
+        return repeat_n_range<std::decay_t<T>>(std::forward<T>(value), n);
+    }
+
+    constexpr repeat_n_closure operator()(std::size_t n) const noexcept { return repeat_n_closure{n}; }
+};
+} // namespace detail
+
+namespace views {
+// views::repeat_n(value, n), or value | views::repeat_n(n), is n copies of value as a repeat_n_range
+inline constexpr detail::repeat_n_adaptor repeat_n{};
+} // namespace views
+} // namespace repeat_n
+#endif
+
+#endif // REPEAT_N_VIEW_RANGES_H
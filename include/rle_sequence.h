@@ -0,0 +1,284 @@
+/*
+ * Copyright 2021 Chandradeep Dey
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef REPEAT_N_VIEW_RLE_SEQUENCE_H
+#define REPEAT_N_VIEW_RLE_SEQUENCE_H
+
+#include "check.h"
+#include "chunk.h"
+#include "extent.h"
+#include "foreign_view.h"
+#include "traits.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <limits>
+#include <type_traits>
+#include <vector>
+
+namespace repeat_n {
+// A concatenation of runtime sized repeat views, stored as one (value, count) pair per run. Appending a run equal to
+// the last one extends it instead, so the runs are always maximal and memory grows with their number, not with size().
+template <typename T, typename Check = default_check> class rle_sequence {
+  public: // types
+    using value_type = T;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using reference = typename std::add_lvalue_reference<typename std::add_const<T>::type>::type;
+    using const_reference = typename std::add_lvalue_reference<typename std::add_const<T>::type>::type;
+    using pointer = typename std::add_pointer<typename std::add_const<T>::type>::type;
+    using const_pointer = typename std::add_pointer<typename std::add_const<T>::type>::type;
+    using run_type = foreign_view<T, dynamic_extent, Check>;
+
+    class const_iterator {
+        // Iterator
+      public:
+        using value_type = rle_sequence::value_type;
+        using difference_type = rle_sequence::difference_type;
+        using reference = rle_sequence::const_reference;
+        using pointer = rle_sequence::const_pointer;
+        using iterator_category = std::random_access_iterator_tag;
+
+      public:
+        const_iterator(const const_iterator &other) = default;
+
+        const_iterator &operator=(const const_iterator &other) = default;
+
+        friend void swap(const_iterator &lhs, const_iterator &rhs) {
+            auto temp = lhs;
+            lhs = rhs;
+            rhs = temp;
+        }
+
+        reference operator*() const { return sequence->M_values[run]; }
+
+        // steps into the next run when it reaches the end of the current one
+        const_iterator &operator++() {
+            if (++curr == sequence->M_ends[run]) {
+                ++run;
+            }
+            return *this;
+        }
+
+        // InputIterator
+        friend bool operator==(const const_iterator &lhs, const const_iterator &rhs) {
+            Check::same_view(lhs.sequence, rhs.sequence, "Requested comparison between different sequences");
+            return lhs.curr == rhs.curr;
+        }
+
+        friend bool operator!=(const const_iterator &lhs, const const_iterator &rhs) { return !(lhs == rhs); }
+
+        pointer operator->() const { return &operator*(); }
+
+        const_iterator operator++(int) & {
+            auto prev = *this;
+            ++*this;
+            return prev;
+        }
+
+        // ForwardIterator
+        const_iterator() = default;
+
+        // BidirectionalIterator
+        const_iterator &operator--() {
+            if (run > 0 && curr == sequence->M_ends[run - 1]) {
+                --run;
+            }
+            --curr;
+            return *this;
+        }
+
+        const_iterator operator--(int) & {
+            auto prev = *this;
+            --*this;
+            return prev;
+        }
+
+        // RandomAccessIterator
+        const_iterator &operator+=(difference_type n) {
+            curr += n;
+            run = sequence->M_locate(curr, run);
+            return *this;
+        }
+
+        friend const_iterator operator+(const_iterator a, difference_type n) { return a += n; }
+
+        friend const_iterator operator+(difference_type n, const_iterator a) { return a + n; }
+
+        const_iterator &operator-=(difference_type n) { return operator+=(-n); }
+
+        friend const_iterator operator-(const_iterator a, difference_type n) { return a -= n; }
+
+        friend difference_type operator-(const const_iterator &a, const const_iterator &b) {
+            Check::same_view(a.sequence, b.sequence, "Requested difference between different sequences");
+            return static_cast<difference_type>(a.curr - b.curr);
+        }
+
+        reference operator[](difference_type n) const { return *(*this + n); }
+
+        friend bool operator<(const const_iterator &a, const const_iterator &b) {
+            Check::same_view(a.sequence, b.sequence, "Requested comparison between different sequences");
+            return a.curr < b.curr;
+        }
+
+        friend bool operator<=(const const_iterator &a, const const_iterator &b) {
+            Check::same_view(a.sequence, b.sequence, "Requested comparison between different sequences");
+            return a.curr <= b.curr;
+        }
+
+        friend bool operator>(const const_iterator &a, const const_iterator &b) { return !(a <= b); }
+
+        friend bool operator>=(const const_iterator &a, const const_iterator &b) { return !(a < b); }
+
+      public: // segmented iteration, see chunk.h
+        template <typename F> void for_each_chunk(const const_iterator &last, F &&f) const {
+            Check::same_view(sequence, last.sequence, "Requested chunks between different sequences");
+            for (size_type pos = curr, r = run; pos < last.curr; ++r) {
+                const size_type stop = std::min(sequence->M_ends[r], last.curr);
+                f(sequence->M_values[r], stop - pos);
+                pos = stop;
+            }
+        }
+
+      private: // constructor only rle_sequence can access
+        friend class rle_sequence;
+
+        const_iterator(const rle_sequence *s, size_type c, size_type r) : sequence(s), curr(c), run(r) {}
+
+      private: // data members
+        const rle_sequence *sequence = nullptr;
+        size_type curr = 0;
+        size_type run = 0; // index of the run containing curr, runs() at the end
+    };
+
+    using iterator = const_iterator;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+    using reverse_iterator = const_reverse_iterator;
+
+  public: // constructors
+    rle_sequence() = default;
+
+    // a view, or any range append accepts
+    template <typename Range> explicit rle_sequence(const Range &range) { append(range); }
+
+  public: // modifiers
+    // extends the last run when value equals it
+    void append(const T &value, size_type count) {
+        if (count == 0) {
+            return;
+        }
+        if (!M_values.empty() && M_values.back() == value) {
+            M_ends.back() += count;
+        } else {
+            M_values.push_back(value);
+            M_ends.push_back(size() + count);
+        }
+    }
+
+    // a view of one element, see traits.h, is a single run
+    template <typename View, detail::enable_if_repeat_view<View> = true> void append(const View &view) {
+        if (view.size() != 0) {
+            append(*view.begin(), view.size());
+        }
+    }
+
+    // Any other range, including an rle_sequence with a different Check or a std::tuple of ranges, is appended one
+    // chunk at a time through for_each_chunk, so each of its runs extends this sequence correctly.
+    template <typename Range, typename std::enable_if<!is_repeat_view<Range>::value, bool>::type = true>
+    void append(const Range &range) {
+        repeat_n::for_each_chunk(range, [this](const T &value, size_type count) { append(value, count); });
+    }
+
+    // the first run of other merges into the last run of this sequence when their values are equal
+    void append(const rle_sequence &other) {
+        if (&other == this) {
+            // merging would grow other's last run while it is still being read
+            const rle_sequence copy(other);
+            append(copy);
+            return;
+        }
+        const size_type runs = other.runs();
+        for (size_type r = 0; r < runs; ++r) {
+            append(other.M_values[r], other.run_size(r));
+        }
+    }
+
+    void clear() noexcept {
+        M_values.clear();
+        M_ends.clear();
+    }
+
+  public: // element access, O(log runs())
+    const_reference operator[](size_type pos) const { return M_values[M_locate(pos, 0)]; }
+
+    const_reference front() const { return M_values.front(); }
+
+    const_reference back() const { return M_values.back(); }
+
+  public: // runs
+    size_type runs() const noexcept { return M_values.size(); }
+
+    size_type run_size(size_type r) const noexcept { return M_ends[r] - (r == 0 ? 0 : M_ends[r - 1]); }
+
+    run_type run(size_type r) const { return run_type(run_size(r), std::addressof(M_values[r])); }
+
+  public: // iterators
+    const_iterator begin() const noexcept { return const_iterator(this, 0, 0); }
+
+    const_iterator cbegin() const noexcept { return begin(); }
+
+    const_iterator end() const noexcept { return const_iterator(this, size(), runs()); }
+
+    const_iterator cend() const noexcept { return end(); }
+
+    const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(end()); }
+
+    const_reverse_iterator crbegin() const noexcept { return rbegin(); }
+
+    const_reverse_iterator rend() const noexcept { return const_reverse_iterator(begin()); }
+
+    const_reverse_iterator crend() const noexcept { return rend(); }
+
+  public: // capacity
+    size_type size() const noexcept { return M_ends.empty() ? 0 : M_ends.back(); }
+
+    bool empty() const noexcept { return M_ends.empty(); }
+
+    difference_type max_size() const noexcept { return std::numeric_limits<difference_type>::max(); }
+
+  public: // comparison, runs are always maximal so equal sequences have equal runs
+    friend bool operator==(const rle_sequence &lhs, const rle_sequence &rhs) {
+        return lhs.M_ends == rhs.M_ends && lhs.M_values == rhs.M_values;
+    }
+
+    friend bool operator!=(const rle_sequence &lhs, const rle_sequence &rhs) { return !(lhs == rhs); }
+
+  private:
+    // index of the run containing pos, checking the run it was last in before falling back to a binary search
+    size_type M_locate(size_type pos, size_type hint) const noexcept {
+        if (hint < runs() && pos < M_ends[hint] && (hint == 0 || pos >= M_ends[hint - 1])) {
+            return hint;
+        }
+        return static_cast<size_type>(std::upper_bound(M_ends.begin(), M_ends.end(), pos) - M_ends.begin());
+    }
+
+    std::vector<T> M_values;
+    std::vector<size_type> M_ends; // prefix sums of the run lengths, M_ends[r] is one past the last index of run r
+};
+} // namespace repeat_n
+
+#endif // REPEAT_N_VIEW_RLE_SEQUENCE_H
@@ -0,0 +1,37 @@
+/*
+ * Copyright 2021 Chandradeep Dey
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef REPEAT_N_VIEW_SENTINEL_H
+#define REPEAT_N_VIEW_SENTINEL_H
+
+#include "config.h"
+
+#include <cstddef>
+
+namespace repeat_n {
+// The end of a view as nothing but its size. An iterator compares equal to it once it has been advanced count times,
+// which is a single integer comparison with no check that both ends belong to the same view. The views keep a full
+// iterator as end() for C++11 algorithms, views::repeat_n in ranges.h ends in one of these.
+struct counted_sentinel {
+    std::size_t count = 0;
+
+    counted_sentinel() = default;
+
+    constexpr explicit counted_sentinel(std::size_t n) noexcept : count(n) {}
+};
+} // namespace repeat_n
+
+#endif // REPEAT_N_VIEW_SENTINEL_H
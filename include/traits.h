@@ -0,0 +1,45 @@
+/*
+ * Copyright 2021 Chandradeep Dey
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef REPEAT_N_VIEW_TRAITS_H
+#define REPEAT_N_VIEW_TRAITS_H
+
+#include <cstddef>
+#include <type_traits>
+
+namespace repeat_n {
+template <typename T, std::size_t N, typename Check, typename Layout> class owned_view;
+template <typename T, std::size_t N, typename Check, typename Layout> class foreign_view;
+
+// Whether V is a view of one element repeated, all that the functions which only read *view.begin() and view.size()
+// can handle. Views with a pattern of several elements, such as cycle_view and rle_sequence, and ordinary containers
+// are not, and take an overload of their own or none at all. The other views of one element specialize this next to
+// their definitions.
+template <typename V> struct is_repeat_view : std::false_type {};
+
+template <typename T, std::size_t N, typename Check, typename Layout>
+struct is_repeat_view<owned_view<T, N, Check, Layout>> : std::true_type {};
+
+template <typename T, std::size_t N, typename Check, typename Layout>
+struct is_repeat_view<foreign_view<T, N, Check, Layout>> : std::true_type {};
+
+namespace detail {
+template <typename View, typename R = bool>
+using enable_if_repeat_view = typename std::enable_if<is_repeat_view<View>::value, R>::type;
+} // namespace detail
+} // namespace repeat_n
+
+#endif // REPEAT_N_VIEW_TRAITS_H
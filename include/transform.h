@@ -0,0 +1,68 @@
+/*
+ * Copyright 2021 Chandradeep Dey
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef REPEAT_N_VIEW_TRANSFORM_H
+#define REPEAT_N_VIEW_TRANSFORM_H
+
+#include "extent.h"
+#include "foreign_view.h"
+#include "owned_view.h"
+
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+namespace repeat_n {
+namespace detail {
+template <typename T, typename F>
+using transform_result = typename std::decay<decltype(std::declval<F &>()(std::declval<const T &>()))>::type;
+
+template <std::size_t N, typename Check, typename Layout, typename R>
+owned_view<R, N, Check, Layout> make_transformed(std::size_t, R &&value, std::false_type) {
+    return owned_view<R, N, Check, Layout>(std::move(value));
+}
+
+template <std::size_t N, typename Check, typename Layout, typename R>
+owned_view<R, N, Check, Layout> make_transformed(std::size_t n, R &&value, std::true_type) {
+    return owned_view<R, N, Check, Layout>(n, std::move(value));
+}
+
+template <std::size_t N, typename Check, typename Layout, typename R>
+owned_view<R, N, Check, Layout> make_transformed(std::size_t n, R &&value) {
+    return make_transformed<N, Check, Layout>(n, std::move(value), std::integral_constant<bool, N == dynamic_extent>{});
+}
+} // namespace detail
+
+// Every element of a view is the same, so transforming it only takes one call. transform(view, f) calls f on the
+// view's element right away, exactly once and even when the view is empty, and returns an owned_view of the result
+// with the same N and size. Dereferencing it is as cheap as dereferencing any other view, and transforming that
+// again calls the next function once as well.
+template <typename T, std::size_t N, typename Check, typename Layout, typename F>
+owned_view<detail::transform_result<T, F>, N, Check, Layout> transform(const owned_view<T, N, Check, Layout> &view,
+                                                                       F &&f) {
+    return detail::make_transformed<N, Check, Layout>(view.size(),
+                                                      detail::transform_result<T, F>(f(view.data())));
+}
+
+// the element is read even when view is empty, so it has to point at a live object
+template <typename T, std::size_t N, typename Check, typename Layout, typename F>
+owned_view<detail::transform_result<T, F>, N, Check, Layout> transform(const foreign_view<T, N, Check, Layout> &view,
+                                                                       F &&f) {
+    return detail::make_transformed<N, Check, Layout>(view.size(), detail::transform_result<T, F>(f(*view.begin())));
+}
+} // namespace repeat_n
+
+#endif // REPEAT_N_VIEW_TRANSFORM_H
@@ -0,0 +1,189 @@
+/*
+ * Copyright 2021 Chandradeep Dey
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// The O(1) algorithm.h overloads, found through ADL, have to answer what the std:: algorithms answer over the
+// materialized buffer. Positions are compared as distances from the beginning.
+
+#include "test.h"
+
+#include <algorithm.h>
+#include <foreign_view.h>
+#include <owned_view.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <limits>
+#include <vector>
+
+namespace {
+const std::size_t sizes[] = {0, 1, 2, 3, 100};
+
+template <typename View> std::vector<int> materialize(const View &view) {
+    return view.size() == 0 ? std::vector<int>() : std::vector<int>(view.size(), *view.begin());
+}
+
+template <typename View> void check_view(const View &view, int value) {
+    using std::adjacent_find;
+    using std::all_of;
+    using std::any_of;
+    using std::binary_search;
+    using std::count;
+    using std::count_if;
+    using std::find;
+    using std::find_if;
+    using std::find_if_not;
+    using std::is_sorted;
+    using std::is_sorted_until;
+    using std::lower_bound;
+    using std::max_element;
+    using std::min_element;
+    using std::minmax_element;
+    using std::none_of;
+    using std::unique;
+    using std::upper_bound;
+
+    auto first = view.begin();
+    auto last = view.end();
+    const std::vector<int> buffer = materialize(view);
+    auto b_first = buffer.begin();
+    auto b_last = buffer.end();
+
+    std::greater<int> greater;
+    for (int probe = value - 1; probe <= value + 1; ++probe) {
+        auto below = [probe](int x) { return x < probe; };
+        auto is = [probe](int x) { return x == probe; };
+
+        CHECK(count(first, last, probe) == std::count(b_first, b_last, probe));
+        CHECK(count_if(first, last, below) == std::count_if(b_first, b_last, below));
+        CHECK(find(first, last, probe) - first == std::find(b_first, b_last, probe) - b_first);
+        CHECK(find_if(first, last, is) - first == std::find_if(b_first, b_last, is) - b_first);
+        CHECK(find_if_not(first, last, is) - first == std::find_if_not(b_first, b_last, is) - b_first);
+        CHECK(all_of(first, last, is) == std::all_of(b_first, b_last, is));
+        CHECK(any_of(first, last, is) == std::any_of(b_first, b_last, is));
+        CHECK(none_of(first, last, is) == std::none_of(b_first, b_last, is));
+
+        CHECK(lower_bound(first, last, probe) - first == std::lower_bound(b_first, b_last, probe) - b_first);
+        CHECK(upper_bound(first, last, probe) - first == std::upper_bound(b_first, b_last, probe) - b_first);
+        CHECK(binary_search(first, last, probe) == std::binary_search(b_first, b_last, probe));
+        // descending order
+        CHECK(lower_bound(first, last, probe, greater) - first ==
+              std::lower_bound(b_first, b_last, probe, greater) - b_first);
+        CHECK(upper_bound(first, last, probe, greater) - first ==
+              std::upper_bound(b_first, b_last, probe, greater) - b_first);
+        CHECK(binary_search(first, last, probe, greater) == std::binary_search(b_first, b_last, probe, greater));
+    }
+
+    std::less_equal<int> less_equal;
+    CHECK(adjacent_find(first, last) - first == std::adjacent_find(b_first, b_last) - b_first);
+    CHECK(adjacent_find(first, last, less_equal) - first ==
+          std::adjacent_find(b_first, b_last, less_equal) - b_first);
+    CHECK(min_element(first, last) - first == std::min_element(b_first, b_last) - b_first);
+    CHECK(max_element(first, last) - first == std::max_element(b_first, b_last) - b_first);
+    CHECK(min_element(first, last, greater) - first ==
+          std::min_element(b_first, b_last, greater) - b_first);
+    CHECK(max_element(first, last, greater) - first ==
+          std::max_element(b_first, b_last, greater) - b_first);
+    auto minmax = minmax_element(first, last);
+    auto b_minmax = std::minmax_element(b_first, b_last);
+    CHECK(minmax.first - first == b_minmax.first - b_first);
+    CHECK(minmax.second - first == b_minmax.second - b_first);
+    CHECK(is_sorted(first, last) == std::is_sorted(b_first, b_last));
+    CHECK(is_sorted(first, last, greater) == std::is_sorted(b_first, b_last, greater));
+    CHECK(is_sorted_until(first, last) - first == std::is_sorted_until(b_first, b_last) - b_first);
+    CHECK(is_sorted_until(first, last, greater) - first ==
+          std::is_sorted_until(b_first, b_last, greater) - b_first);
+
+    std::vector<int> unique_buffer = buffer;
+    CHECK(unique(first, last) - first ==
+          std::unique(unique_buffer.begin(), unique_buffer.end()) - unique_buffer.begin());
+}
+
+template <typename View1, typename View2> void check_equal(const View1 &view1, const View2 &view2) {
+    using std::equal;
+    const std::vector<int> buffer1 = materialize(view1);
+    const std::vector<int> buffer2 = materialize(view2);
+    std::less_equal<int> less_equal;
+    CHECK(equal(view1.begin(), view1.end(), view2.begin(), view2.end()) ==
+          std::equal(buffer1.begin(), buffer1.end(), buffer2.begin(), buffer2.end()));
+    CHECK(equal(view1.begin(), view1.end(), view2.begin(), view2.end(), less_equal) ==
+          std::equal(buffer1.begin(), buffer1.end(), buffer2.begin(), buffer2.end(), less_equal));
+}
+
+// NaN is unequal to itself and never_equal never holds, so neither unique nor adjacent_find finds a duplicate
+void check_unequal_to_itself() {
+    using std::adjacent_find;
+    using std::unique;
+    auto never_equal = [](int, int) { return false; };
+    for (std::size_t n : sizes) {
+        const double nan = std::numeric_limits<double>::quiet_NaN();
+        const repeat_n::foreign_view<double, repeat_n::dynamic_extent> nans(n, &nan);
+        std::vector<double> buffer(n, nan);
+        CHECK(adjacent_find(nans.begin(), nans.end()) - nans.begin() ==
+              std::adjacent_find(buffer.begin(), buffer.end()) - buffer.begin());
+        CHECK(unique(nans.begin(), nans.end()) - nans.begin() ==
+              std::unique(buffer.begin(), buffer.end()) - buffer.begin());
+
+        const repeat_n::owned_view<int, repeat_n::dynamic_extent> ints(n, 1);
+        std::vector<int> int_buffer(n, 1);
+        CHECK(unique(ints.begin(), ints.end(), never_equal) - ints.begin() ==
+              std::unique(int_buffer.begin(), int_buffer.end(), never_equal) - int_buffer.begin());
+    }
+}
+} // namespace
+
+int main() {
+    check_unequal_to_itself();
+
+    const int values[] = {-5, 0, 7};
+    for (std::size_t n : sizes) {
+        for (const int &value : values) {
+            check_view(repeat_n::owned_view<int, repeat_n::dynamic_extent>(n, value), value);
+            check_view(repeat_n::foreign_view<int, repeat_n::dynamic_extent>(n, &value), value);
+        }
+    }
+
+    for (std::size_t n1 : sizes) {
+        for (std::size_t n2 : sizes) {
+            for (const int &value1 : values) {
+                for (const int &value2 : values) {
+                    const repeat_n::owned_view<int, repeat_n::dynamic_extent> owned1(n1, value1);
+                    const repeat_n::owned_view<int, repeat_n::dynamic_extent> owned2(n2, value2);
+                    const repeat_n::foreign_view<int, repeat_n::dynamic_extent> foreign1(n1, &value1);
+                    const repeat_n::foreign_view<int, repeat_n::dynamic_extent> foreign2(n2, &value2);
+                    check_equal(owned1, owned2);
+                    check_equal(owned1, foreign2);
+                    check_equal(foreign1, owned2);
+                    check_equal(foreign1, foreign2);
+                }
+            }
+        }
+    }
+
+    // far too long to walk, so these only finish when ADL picked the O(1) overloads
+    const repeat_n::owned_view<int, repeat_n::dynamic_extent> huge(std::size_t(1) << 40, 3);
+    {
+        using std::count;
+        using std::equal;
+        using std::find_if_not;
+        using std::is_sorted_until;
+        CHECK(count(huge.begin(), huge.end(), 3) == std::ptrdiff_t(1) << 40);
+        CHECK(find_if_not(huge.begin(), huge.end(), [](int x) { return x == 3; }) == huge.end());
+        CHECK(is_sorted_until(huge.begin(), huge.end()) == huge.end());
+        CHECK(equal(huge.begin(), huge.end(), huge.begin(), huge.end()));
+    }
+    return test::result();
+}
@@ -0,0 +1,88 @@
+/*
+ * Copyright 2021 Chandradeep Dey
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// crc32 and polynomial_hash of a view have to equal those of the materialized buffer, byte for byte.
+
+#include "test.h"
+
+#include <checksum.h>
+#include <foreign_view.h>
+#include <owned_view.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace {
+// no padding, so every byte of the object representation is set
+struct record {
+    std::uint32_t id;
+    std::uint16_t flags;
+    std::uint8_t tag[2];
+};
+
+const std::size_t sizes[] = {0, 1, 2, 3, 5, 7, 8, 13, 64, 100, 255, 256, 1000, 4097, 65537};
+
+template <typename T> void check_sizes(const T &value) {
+    for (std::size_t n : sizes) {
+        const std::vector<T> buffer(n, value);
+        const repeat_n::owned_view<T, repeat_n::dynamic_extent> owned(n, value);
+        const repeat_n::foreign_view<T, repeat_n::dynamic_extent> foreign(n, &value);
+        for (std::uint32_t seed : {0u, 0xdeadbeefu}) {
+            const std::uint32_t crc = repeat_n::crc32(buffer.data(), n * sizeof(T), seed);
+            CHECK(repeat_n::crc32(owned, seed) == crc);
+            CHECK(repeat_n::crc32(foreign, seed) == crc);
+
+            const std::uint64_t hash = repeat_n::polynomial_hash(buffer.data(), n * sizeof(T), seed);
+            CHECK(repeat_n::polynomial_hash(owned, seed) == hash);
+            CHECK(repeat_n::polynomial_hash(foreign, seed) == hash);
+
+            const std::uint64_t based = repeat_n::polynomial_hash(buffer.data(), n * sizeof(T), seed, 131);
+            CHECK(repeat_n::polynomial_hash(owned, seed, 131) == based);
+        }
+    }
+}
+} // namespace
+
+int main() {
+    // the check value of CRC-32, and continuing from the CRC of a prefix
+    CHECK(repeat_n::crc32("123456789", 9) == 0xcbf43926u);
+    CHECK(repeat_n::crc32("56789", 5, repeat_n::crc32("1234", 4)) == 0xcbf43926u);
+    CHECK(repeat_n::polynomial_hash("56789", 5, repeat_n::polynomial_hash("1234", 4)) ==
+          repeat_n::polynomial_hash("123456789", 9));
+
+    // zero padding of different lengths hashes differently
+    CHECK(repeat_n::polynomial_hash(repeat_n::owned_view<char, 3>('\0')) !=
+          repeat_n::polynomial_hash(repeat_n::owned_view<char, 4>('\0')));
+
+    // a base is taken modulo 2^61 - 1, however large
+    const std::uint64_t mersenne61 = (std::uint64_t(1) << 61) - 1;
+    const std::vector<std::uint32_t> words(1000, 0xdeadbeef);
+    for (std::uint64_t base : {std::uint64_t(131), repeat_n::default_polynomial_base, mersenne61 - 1}) {
+        const std::uint64_t hash = repeat_n::polynomial_hash(words.data(), words.size() * 4, 0, base);
+        for (std::uint64_t large : {base + mersenne61, base + 2 * mersenne61, base + 7 * mersenne61}) {
+            CHECK(repeat_n::polynomial_hash(words.data(), words.size() * 4, 0, large) == hash);
+            CHECK(repeat_n::polynomial_hash(repeat_n::owned_view<std::uint32_t, 1000>(0xdeadbeef), 0, large) == hash);
+        }
+    }
+
+    check_sizes<char>('x');
+    check_sizes<std::uint8_t>(0);
+    check_sizes<std::uint32_t>(0x01020304);
+    check_sizes<double>(3.25);
+    check_sizes<record>(record{0x01020304, 0xabcd, {0, 7}});
+    return test::result();
+}
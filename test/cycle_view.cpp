@@ -0,0 +1,80 @@
+/*
+ * Copyright 2021 Chandradeep Dey
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// cycle_view has to read, walk and fill exactly like the buffer that holds its pattern n times over.
+
+#include "test.h"
+
+#include <cycle_view.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <string>
+#include <vector>
+
+namespace {
+const std::size_t repetitions[] = {0, 1, 2, 3, 7, 64, 1000};
+
+template <typename T> void check_pattern(const std::vector<T> &pattern) {
+    for (std::size_t n : repetitions) {
+        std::vector<T> buffer;
+        for (std::size_t r = 0; r < n; ++r) {
+            buffer.insert(buffer.end(), pattern.begin(), pattern.end());
+        }
+        const repeat_n::cycle_view<T> view(n, pattern.data(), pattern.size());
+
+        CHECK(view.size() == buffer.size());
+        CHECK(view.empty() == buffer.empty());
+        CHECK(view.end() - view.begin() == static_cast<std::ptrdiff_t>(buffer.size()));
+        CHECK(std::equal(view.begin(), view.end(), buffer.begin()));
+        CHECK(std::equal(view.rbegin(), view.rend(), buffer.rbegin()));
+
+        bool indexed = true;
+        for (std::size_t i = 0; i < buffer.size(); ++i) {
+            indexed = indexed && view[i] == buffer[i] && view.begin()[static_cast<std::ptrdiff_t>(i)] == buffer[i];
+        }
+        CHECK(indexed);
+
+        // random jumps both ways, landing on every phase
+        bool jumped = true;
+        for (std::size_t i = 0; i < buffer.size(); i += 5) {
+            jumped = jumped && *(view.begin() + static_cast<std::ptrdiff_t>(i)) == buffer[i];
+            jumped = jumped && *(view.end() - static_cast<std::ptrdiff_t>(buffer.size() - i)) == buffer[i];
+        }
+        CHECK(jumped);
+
+        std::vector<T> filled(buffer.size());
+        CHECK(repeat_n::fill_into(view, filled.data()) == filled.data() + filled.size());
+        CHECK(filled == buffer);
+
+        std::vector<T> appended;
+        repeat_n::fill_into(view, std::back_inserter(appended));
+        CHECK(appended == buffer);
+    }
+}
+} // namespace
+
+int main() {
+    check_pattern(std::vector<char>{'x'});
+    check_pattern(std::vector<char>{'a', 'b', 'c'});
+    check_pattern(std::vector<std::uint32_t>{1, 2, 3, 4, 5, 6, 7});
+    check_pattern(std::vector<double>{0.5, -1.0});
+    // not trivially copyable, so std::copy instead of memcpy
+    check_pattern(std::vector<std::string>{"one", "two", "three", "four"});
+    return test::result();
+}
@@ -0,0 +1,59 @@
+/*
+ * Copyright 2021 Chandradeep Dey
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef REPEAT_N_TEST_FAILING_THREADS_H
+#define REPEAT_N_TEST_FAILING_THREADS_H
+
+// Included by exactly one source file of a test, this replaces pthread_create so that only the first threads_allowed
+// threads start and std::thread's constructor throws std::system_error for the rest. Glibc only, where a definition
+// in the executable takes precedence over the C library's.
+#include <atomic>
+#include <cerrno>
+
+#if defined(__GLIBC__)
+#include <dlfcn.h>
+#include <pthread.h>
+
+#define REPEAT_N_TEST_CAN_FAIL_THREADS 1
+
+namespace test {
+// -1 lets every thread start
+inline std::atomic<int> &threads_allowed() {
+    static std::atomic<int> allowed(-1);
+    return allowed;
+}
+} // namespace test
+
+extern "C" int pthread_create(pthread_t *thread, const pthread_attr_t *attr, void *(*start)(void *), void *arg) {
+    using create = int (*)(pthread_t *, const pthread_attr_t *, void *(*)(void *), void *);
+    static const create real = reinterpret_cast<create>(dlsym(RTLD_NEXT, "pthread_create"));
+    std::atomic<int> &allowed = test::threads_allowed();
+    int left = allowed.load();
+    while (left != -1) {
+        if (left == 0) {
+            return EAGAIN;
+        }
+        if (allowed.compare_exchange_weak(left, left - 1)) {
+            break;
+        }
+    }
+    return real(thread, attr, start, arg);
+}
+#else
+#define REPEAT_N_TEST_CAN_FAIL_THREADS 0
+#endif
+
+#endif // REPEAT_N_TEST_FAILING_THREADS_H
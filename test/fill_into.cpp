@@ -0,0 +1,114 @@
+/*
+ * Copyright 2021 Chandradeep Dey
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// fill_into has to write exactly what a plain loop over the view writes, whatever the alignment of dest and however
+// the output splits into an unaligned head, whole vectors and a tail.
+
+#include "test.h"
+
+#include <fill_into.h>
+#include <owned_view.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <vector>
+
+namespace {
+// S bytes that all differ, so a pattern rotated by the wrong amount shows up
+template <std::size_t S> struct bytes {
+    unsigned char b[S];
+};
+
+template <typename T> T distinct_bytes() {
+    T value;
+    unsigned char raw[sizeof(T)];
+    for (std::size_t i = 0; i < sizeof(T); ++i) {
+        raw[i] = static_cast<unsigned char>(7 * i + 1);
+    }
+    std::memcpy(&value, raw, sizeof(T));
+    return value;
+}
+
+// output lengths in bytes on both sides of the SSE2, AVX2 and AVX-512 widths and of four unrolled vectors
+const std::size_t lengths[] = {0, 1, 2, 3, 15, 16, 17, 31, 32, 33, 63, 64, 65, 127, 128, 129, 191, 192, 193, 255, 256,
+                               257, 1000, 4096};
+
+const repeat_n::store_mode modes[] = {repeat_n::store_mode::automatic, repeat_n::store_mode::temporal,
+                                      repeat_n::store_mode::non_temporal};
+
+const unsigned char canary = 0xa5;
+const std::size_t margin = 128;
+
+template <typename T> void check_type() {
+    const T value = distinct_bytes<T>();
+    std::vector<unsigned char> storage(margin + 64 + 4096 + margin + 64);
+    // the first byte of storage that is 64-byte aligned, plus the margin
+    const std::size_t base = margin + (64 - reinterpret_cast<std::uintptr_t>(storage.data()) % 64) % 64;
+
+    for (std::size_t length : lengths) {
+        const std::size_t n = length / sizeof(T);
+        const repeat_n::owned_view<T, repeat_n::dynamic_extent> view(n, value);
+
+        std::vector<unsigned char> expected(n * sizeof(T));
+        for (std::size_t i = 0; i < n; ++i) {
+            std::memcpy(expected.data() + i * sizeof(T), &value, sizeof(T));
+        }
+
+        for (std::size_t offset = 0; offset < 64; offset += alignof(T)) {
+            for (repeat_n::store_mode mode : modes) {
+                std::memset(storage.data(), canary, storage.size());
+                T *dest = reinterpret_cast<T *>(storage.data() + base + offset);
+                CHECK(repeat_n::fill_into(view, dest, mode) == dest + n);
+
+                const unsigned char *out = storage.data() + base + offset;
+                CHECK(n == 0 || std::memcmp(out, expected.data(), expected.size()) == 0);
+                bool untouched = true;
+                for (std::size_t i = 0; i < storage.size(); ++i) {
+                    if (storage.data() + i < out || storage.data() + i >= out + expected.size()) {
+                        untouched = untouched && storage[i] == canary;
+                    }
+                }
+                CHECK(untouched);
+            }
+        }
+
+        // not a T *, so the iterator loop
+        std::vector<T> appended;
+        repeat_n::fill_into(view, std::back_inserter(appended));
+        CHECK(appended.size() == n);
+        CHECK(n == 0 || std::memcmp(appended.data(), expected.data(), expected.size()) == 0);
+    }
+}
+} // namespace
+
+int main() {
+    check_type<std::uint8_t>();
+    check_type<std::uint16_t>();
+    check_type<std::uint32_t>();
+    check_type<std::uint64_t>();
+    check_type<double>();
+    check_type<bytes<2>>();
+    check_type<bytes<4>>();
+    check_type<bytes<8>>();
+    check_type<bytes<16>>();
+    check_type<bytes<32>>();
+    check_type<bytes<64>>();
+    // 64 % 3 != 0, so no vector path
+    check_type<bytes<3>>();
+    return test::result();
+}
@@ -0,0 +1,93 @@
+/*
+ * Copyright 2021 Chandradeep Dey
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// fold over a view has to give what std::accumulate gives over the materialized buffer, through repeated squaring
+// and through the closed forms for sums and products.
+
+#include "test.h"
+
+#include <fold.h>
+#include <foreign_view.h>
+#include <owned_view.h>
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <numeric>
+#include <string>
+#include <vector>
+
+namespace {
+const std::size_t sizes[] = {0, 1, 2, 3, 4, 5, 7, 8, 15, 16, 17, 31, 100, 1000, 4097};
+
+// 2x2 matrices of integers modulo 2^64, whose product is associative but not commutative
+struct matrix {
+    std::uint64_t a, b, c, d;
+
+    friend bool operator==(const matrix &x, const matrix &y) {
+        return x.a == y.a && x.b == y.b && x.c == y.c && x.d == y.d;
+    }
+};
+
+matrix multiply(const matrix &x, const matrix &y) {
+    return {x.a * y.a + x.b * y.c, x.a * y.b + x.b * y.d, x.c * y.a + x.d * y.c, x.c * y.b + x.d * y.d};
+}
+
+bool close(double x, double y) { return x == y || std::fabs(x - y) <= 1e-10 * std::fmax(1.0, std::fabs(y)); }
+
+template <typename T, typename BinaryOp, typename Init, typename Equal>
+void check_sizes(const T &value, BinaryOp op, Init init, Equal equal) {
+    for (std::size_t n : sizes) {
+        const std::vector<T> buffer(n, value);
+        const Init expected = std::accumulate(buffer.begin(), buffer.end(), init, op);
+        const repeat_n::owned_view<T, repeat_n::dynamic_extent> owned(n, value);
+        const repeat_n::foreign_view<T, repeat_n::dynamic_extent> foreign(n, &value);
+        CHECK(equal(repeat_n::fold(owned, op, init), expected));
+        CHECK(equal(repeat_n::fold(foreign, op, init), expected));
+    }
+}
+
+template <typename T> bool same(const T &x, const T &y) { return x == y; }
+} // namespace
+
+int main() {
+    // squaring
+    check_sizes(std::string("ab"), std::plus<std::string>(), std::string("<"), same<std::string>);
+    check_sizes(matrix{1, 1, 1, 0}, multiply, matrix{1, 0, 0, 1}, same<matrix>);
+    check_sizes(matrix{3, 5, 7, 11}, multiply, matrix{2, 0, 1, 2}, same<matrix>);
+    check_sizes(std::uint64_t(0x9e3779b97f4a7c15), std::multiplies<std::uint64_t>(), std::uint64_t(3),
+                same<std::uint64_t>);
+    check_sizes(std::uint32_t(0x9e3779b9), std::bit_xor<std::uint32_t>(), std::uint32_t(5), same<std::uint32_t>);
+
+    // the sum closed form
+    check_sizes(7, std::plus<int>(), 11, same<int>);
+    check_sizes(std::int64_t(-123456789), std::plus<std::int64_t>(), std::int64_t(42), same<std::int64_t>);
+    check_sizes(0.5, std::plus<double>(), 0.25, close);
+    check_sizes(0.1, std::plus<double>(), 0.0, close);
+
+    // the product closed form
+    check_sizes(1.5, std::multiplies<double>(), 2.0, close);
+    check_sizes(-0.999, std::multiplies<double>(), 1.0, close);
+
+#if __cplusplus >= 201402L
+    check_sizes(3, std::plus<>(), 1.5, close);
+    check_sizes(0.5, std::plus<>(), 1.0, close);
+    check_sizes(1.25, std::multiplies<>(), 3.0, close);
+    check_sizes(3u, std::multiplies<>(), 1ull, same<unsigned long long>);
+#endif
+    return test::result();
+}
@@ -0,0 +1,89 @@
+/*
+ * Copyright 2021 Chandradeep Dey
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// Without REPEAT_N_INSTRUMENT the counting hooks have to cost nothing. Everything below is checked at compile time:
+// iterating, comparing and constructing views still works in constant expressions, which any generated call or
+// store to a counter would rule out, the views and iterators keep their sizes, and the hook's arguments are never
+// evaluated.
+
+#include "test.h"
+
+#include <foreign_view.h>
+#include <instrument.h>
+#include <owned_view.h>
+
+#include <cstddef>
+
+#ifdef REPEAT_N_INSTRUMENT
+#error "this test checks the build without REPEAT_N_INSTRUMENT"
+#endif
+
+namespace {
+using view = repeat_n::owned_view<int, 8, repeat_n::unchecked>;
+using dynamic_view = repeat_n::foreign_view<int, repeat_n::dynamic_extent, repeat_n::unchecked>;
+
+struct pointer_and_count {
+    const int *pointer;
+    std::size_t count;
+};
+
+static_assert(sizeof(view) == sizeof(int), "an owned_view is its element");
+static_assert(sizeof(dynamic_view) == sizeof(pointer_and_count), "a foreign_view is a pointer and a size");
+static_assert(sizeof(dynamic_view::const_iterator) == sizeof(pointer_and_count),
+              "an iterator is a pointer and a count");
+
+// every hook on the way, ++, --, +=, *, [], ==, <, <=, - and the constructors
+constexpr int walk() {
+    view v(3);
+    int sum = 0;
+    for (auto it = v.begin(); it != v.end(); ++it) {
+        sum += *it;
+    }
+    auto last = v.end();
+    --last;
+    last -= 1;
+    last += 1;
+    sum += last[0] + static_cast<int>(last - v.begin());
+    sum += v.begin() < last && v.begin() <= last;
+    return sum;
+}
+
+static_assert(walk() == 3 * 8 + 3 + 7 + 1, "the hooks have to stay usable in constant expressions");
+
+constexpr int foreign_walk(const int *p) {
+    dynamic_view v(4, p);
+    int sum = 0;
+    for (auto it = v.begin(); it != v.end(); ++it) {
+        sum += *it;
+    }
+    return sum;
+}
+
+constexpr int element = 5;
+static_assert(foreign_walk(&element) == 20, "the hooks have to stay usable in constant expressions");
+
+int evaluated = 0;
+
+int touch() { return ++evaluated; }
+} // namespace
+
+int main() {
+    REPEAT_N_COUNT_IF(touch() != 0, view, cross_view_comparison);
+    CHECK(evaluated == 0);
+    // the one call that is not swallowed
+    CHECK(touch() == 1);
+    return test::result();
+}
@@ -0,0 +1,79 @@
+/*
+ * Copyright 2021 Chandradeep Dey
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// With REPEAT_N_INSTRUMENT every hook counts once per call, per type and across threads.
+
+#include "test.h"
+
+#include <foreign_view.h>
+#include <instrument.h>
+#include <owned_view.h>
+
+#include <string>
+#include <thread>
+#include <typeinfo>
+
+#ifndef REPEAT_N_INSTRUMENT
+#error "this test checks the build with REPEAT_N_INSTRUMENT"
+#endif
+
+namespace {
+using view = repeat_n::owned_view<int, 8, repeat_n::unchecked>;
+using dynamic_view = repeat_n::foreign_view<int, repeat_n::dynamic_extent, repeat_n::unchecked>;
+
+template <typename T> repeat_n::instrument::counters counts() {
+    return repeat_n::instrument::snapshot()[typeid(T).name()];
+}
+} // namespace
+
+int main() {
+    view v(3);
+    int sum = 0;
+    for (auto it = v.begin(); it != v.end(); ++it) {
+        sum += *it;
+    }
+    auto last = v.end();
+    --last;
+    --last;
+    last += 1;
+    sum += last[0];
+    CHECK(sum == 27);
+
+    const repeat_n::instrument::counters owned = counts<view::iterator>();
+    CHECK(owned.dereferences == 9);
+    CHECK(owned.increments == 8);
+    CHECK(owned.decrements == 2);
+    CHECK(owned.jumps == 1);
+    CHECK(owned.cross_view_comparisons == 0);
+    CHECK(counts<view>().views_constructed == 1);
+
+    // counted on another thread, which has exited by the time of the snapshot
+    std::thread([] {
+        const int a = 1;
+        const int b = 2;
+        dynamic_view x(2, &a);
+        dynamic_view y(2, &b);
+        // unchecked compares only the counts, the comparison is still counted as crossing views
+        CHECK(x.begin() == y.begin());
+        CHECK(*x.begin() == 1);
+    }).join();
+
+    const repeat_n::instrument::counters foreign = counts<dynamic_view::const_iterator>();
+    CHECK(foreign.cross_view_comparisons == 1);
+    CHECK(foreign.dereferences == 1);
+    CHECK(counts<dynamic_view>().views_constructed == 2);
+    return test::result();
+}
@@ -0,0 +1,74 @@
+/*
+ * Copyright 2021 Chandradeep Dey
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// Every layout has to walk a view the same way, plain has to keep one iterator type per T, and tagged has to make the
+// iterator a pointer wide where it can.
+
+#include "test.h"
+
+#include <foreign_view.h>
+#include <owned_view.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace {
+static_assert(std::is_same<repeat_n::owned_view<int, 5>::iterator,
+                           repeat_n::owned_view<int, repeat_n::dynamic_extent>::iterator>::value,
+              "plain iterators do not depend on N");
+using plain_view = repeat_n::owned_view<int, 5, repeat_n::default_check, repeat_n::plain>;
+static_assert(std::is_same<repeat_n::owned_view<int, 5>, plain_view>::value, "plain is the default");
+
+#if REPEAT_N_CAN_TAG_POINTERS
+static_assert(sizeof(repeat_n::foreign_view<int, 1000, repeat_n::unchecked, repeat_n::tagged>::const_iterator) ==
+                  sizeof(void *),
+              "a tagged iterator is a pointer");
+#endif
+
+template <std::size_t N, typename Layout> bool walks() {
+    const int value = 9;
+    const repeat_n::foreign_view<int, N, repeat_n::unchecked, Layout> view(&value);
+    std::size_t steps = 0;
+    bool ok = true;
+    for (auto it = view.begin(); it != view.end(); ++it) {
+        ok = ok && *it == 9 && static_cast<std::size_t>(it - view.begin()) == steps;
+        ++steps;
+    }
+    auto last = view.end();
+    for (std::size_t i = 0; i < N; ++i) {
+        --last;
+    }
+    ok = ok && last == view.begin() && view.begin() + static_cast<std::ptrdiff_t>(N) == view.end();
+    return ok && steps == N && view.end() - view.begin() == static_cast<std::ptrdiff_t>(N);
+}
+
+template <typename Layout> void check_layout() {
+    CHECK((walks<1, Layout>()));
+    CHECK((walks<255, Layout>()));
+    CHECK((walks<256, Layout>()));
+    CHECK((walks<65535, Layout>()));
+    CHECK((walks<65536, Layout>()));
+    CHECK((walks<100000, Layout>()));
+}
+} // namespace
+
+int main() {
+    check_layout<repeat_n::plain>();
+    check_layout<repeat_n::compact>();
+    check_layout<repeat_n::tagged>();
+    return test::result();
+}
@@ -0,0 +1,75 @@
+/*
+ * Copyright 2021 Chandradeep Dey
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// mapped_span has to hold what the view holds, mapped or copied, keep over-aligned elements aligned and refuse a size
+// whose byte count does not fit in a size_t.
+
+#include "test.h"
+
+#include <mapped_span.h>
+#include <owned_view.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <new>
+
+namespace {
+// 192 bytes do not divide a page, so this always takes the copying path
+struct alignas(64) wide {
+    unsigned char bytes[192];
+};
+
+template <typename T> bool holds(const repeat_n::mapped_span<T> &span, const T &value, std::size_t n) {
+    bool ok = span.size() == n && span.end() - span.begin() == static_cast<std::ptrdiff_t>(n);
+    for (std::size_t i = 0; ok && i < n; ++i) {
+        ok = std::memcmp(&span[i], &value, sizeof(T)) == 0;
+    }
+    return ok;
+}
+} // namespace
+
+int main() {
+    for (std::size_t n : {0, 1, 2, 1000, 100000}) {
+        const std::uint32_t word = 0x01020304;
+        using words_view = repeat_n::owned_view<std::uint32_t, repeat_n::dynamic_extent>;
+        const repeat_n::mapped_span<std::uint32_t> words(words_view(n, word));
+        CHECK(holds(words, word, n));
+
+        wide w;
+        for (std::size_t i = 0; i < sizeof(w.bytes); ++i) {
+            w.bytes[i] = static_cast<unsigned char>(i);
+        }
+        const repeat_n::mapped_span<wide> wides(repeat_n::owned_view<wide, repeat_n::dynamic_extent>(n, w));
+        CHECK(holds(wides, w, n));
+        CHECK(!wides.is_mapped());
+        CHECK(reinterpret_cast<std::uintptr_t>(wides.data()) % alignof(wide) == 0);
+    }
+
+#ifndef REPEAT_N_NO_EXCEPTIONS
+    // n * sizeof(T) overflows
+    bool thrown = false;
+    try {
+        const std::size_t n = std::numeric_limits<std::size_t>::max() / sizeof(std::uint64_t) + 1;
+        repeat_n::mapped_span<std::uint64_t> span(repeat_n::owned_view<std::uint64_t, repeat_n::dynamic_extent>(n, 1));
+    } catch (const std::bad_array_new_length &) {
+        thrown = true;
+    }
+    CHECK(thrown);
+#endif
+    return test::result();
+}
@@ -0,0 +1,58 @@
+/*
+ * Copyright 2021 Chandradeep Dey
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// parallel_fill has to write what a plain loop writes, also when some of its threads cannot be started.
+
+#include "failing_threads.h"
+#include "test.h"
+
+#include <owned_view.h>
+#include <parallel_fill.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace {
+// large enough for every thread to get a run of its own
+const std::size_t n = std::size_t(1) << 22;
+
+bool filled(unsigned threads) {
+    const std::uint32_t value = 0x01020304;
+    std::vector<std::uint32_t> buffer(n + 1, 0);
+    const repeat_n::owned_view<std::uint32_t, repeat_n::dynamic_extent> view(n, value);
+    bool ok = repeat_n::parallel_fill(view, buffer.data(), threads) == buffer.data() + n;
+    for (std::size_t i = 0; ok && i < n; ++i) {
+        ok = buffer[i] == value;
+    }
+    return ok && buffer[n] == 0;
+}
+} // namespace
+
+int main() {
+    for (unsigned threads : {1u, 2u, 3u, 8u}) {
+        CHECK(filled(threads));
+    }
+#if REPEAT_N_TEST_CAN_FAIL_THREADS && !defined(REPEAT_N_NO_EXCEPTIONS)
+    // the calling thread takes over the runs of the threads that could not be started
+    for (int allowed : {0, 1, 2}) {
+        test::threads_allowed() = allowed;
+        CHECK(filled(8));
+    }
+    test::threads_allowed() = -1;
+#endif
+    return test::result();
+}
@@ -0,0 +1,100 @@
+/*
+ * Copyright 2021 Chandradeep Dey
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// parallel_for_each has to call f exactly once per index, also when some of its threads cannot be started, and an
+// exception from f has to reach the caller instead of terminating the program.
+
+#include "failing_threads.h"
+#include "test.h"
+
+#include <owned_view.h>
+#include <parallel_for_each.h>
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+namespace {
+const std::size_t n = 100000;
+
+bool each_once(unsigned threads, std::size_t grain) {
+    std::unique_ptr<std::atomic<int>[]> calls(new std::atomic<int>[n]);
+    for (std::size_t i = 0; i < n; ++i) {
+        calls[i] = 0;
+    }
+    const repeat_n::owned_view<int, repeat_n::dynamic_extent> view(n, 7);
+    std::atomic<bool> values(true);
+    repeat_n::parallel_for_each(
+        view,
+        [&](std::size_t i, int value) {
+            ++calls[i];
+            if (value != 7) {
+                values = false;
+            }
+        },
+        threads, grain);
+    bool ok = values.load();
+    for (std::size_t i = 0; ok && i < n; ++i) {
+        ok = calls[i] == 1;
+    }
+    return ok;
+}
+
+#ifndef REPEAT_N_NO_EXCEPTIONS
+// whether the exception thrown at index `at` reached the caller
+bool rethrows(unsigned threads, std::size_t at) {
+    const repeat_n::owned_view<int, repeat_n::dynamic_extent> view(n, 7);
+    try {
+        repeat_n::parallel_for_each(
+            view,
+            [at](std::size_t i, int) {
+                if (i == at) {
+                    throw std::runtime_error("index " + std::to_string(i));
+                }
+            },
+            threads);
+    } catch (const std::runtime_error &e) {
+        return e.what() == "index " + std::to_string(at);
+    }
+    return false;
+}
+#endif
+} // namespace
+
+int main() {
+    for (unsigned threads : {1u, 2u, 3u, 8u}) {
+        for (std::size_t grain : {std::size_t(0), std::size_t(1), std::size_t(1000)}) {
+            CHECK(each_once(threads, grain));
+        }
+#ifndef REPEAT_N_NO_EXCEPTIONS
+        // the calling thread has the first share, the last thread the last one
+        CHECK(rethrows(threads, 0));
+        CHECK(rethrows(threads, n - 1));
+#endif
+    }
+#if REPEAT_N_TEST_CAN_FAIL_THREADS && !defined(REPEAT_N_NO_EXCEPTIONS)
+    // the threads that did start, or the calling thread alone, take over the shares of those that did not
+    for (int allowed : {0, 1, 2}) {
+        test::threads_allowed() = allowed;
+        CHECK(each_once(8, 0));
+        CHECK(rethrows(8, n - 1));
+    }
+    test::threads_allowed() = -1;
+#endif
+    return test::result();
+}
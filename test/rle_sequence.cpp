@@ -0,0 +1,139 @@
+/*
+ * Copyright 2021 Chandradeep Dey
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// rle_sequence has to index, walk and grow exactly like the std::vector holding the same elements, while keeping its
+// runs maximal.
+
+#include "test.h"
+
+#include <foreign_view.h>
+#include <owned_view.h>
+#include <rle_sequence.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+namespace {
+using sequence = repeat_n::rle_sequence<int>;
+
+// the elements and the number of maximal runs in them
+bool matches(const sequence &s, const std::vector<int> &expected) {
+    std::size_t runs = 0;
+    for (std::size_t i = 0; i < expected.size(); ++i) {
+        runs += i == 0 || expected[i] != expected[i - 1];
+    }
+    bool ok = s.size() == expected.size() && s.empty() == expected.empty() && s.runs() == runs;
+    ok = ok && std::equal(s.begin(), s.end(), expected.begin()) && std::equal(s.rbegin(), s.rend(), expected.rbegin());
+    ok = ok && s.end() - s.begin() == static_cast<std::ptrdiff_t>(expected.size());
+    for (std::size_t i = 0; ok && i < expected.size(); ++i) {
+        const auto d = static_cast<std::ptrdiff_t>(i);
+        const auto from_end = static_cast<std::ptrdiff_t>(expected.size() - i);
+        ok = s[i] == expected[i] && s.begin()[d] == expected[i] && *(s.end() - from_end) == expected[i];
+    }
+    // jumps that leave the run an iterator was last in, both ways
+    auto it = s.begin();
+    for (std::size_t i = 0; ok && i < expected.size(); i += 3) {
+        ok = *it == expected[i];
+        it += 3;
+    }
+    for (std::size_t i = expected.size(); ok && i-- > 0;) {
+        ok = *(s.begin() + static_cast<std::ptrdiff_t>(i)) == expected[i];
+    }
+    return ok;
+}
+
+void append(std::vector<int> &v, int value, std::size_t count) { v.insert(v.end(), count, value); }
+
+void check_append() {
+    sequence s;
+    std::vector<int> expected;
+    CHECK(matches(s, expected));
+
+    s.append(1, 2);
+    append(expected, 1, 2);
+    s.append(1, 0);
+    CHECK(matches(s, expected));
+
+    // equal to the last run, so it extends it
+    s.append(1, 3);
+    append(expected, 1, 3);
+    CHECK(matches(s, expected));
+
+    s.append(repeat_n::owned_view<int, 4>(2));
+    append(expected, 2, 4);
+    const int three = 3;
+    s.append(repeat_n::foreign_view<int, repeat_n::dynamic_extent>(1, &three));
+    append(expected, 3, 1);
+    s.append(repeat_n::foreign_view<int, repeat_n::dynamic_extent>(0, &three));
+    s.append(repeat_n::owned_view<int, repeat_n::dynamic_extent>(5, 3));
+    append(expected, 3, 5);
+    CHECK(matches(s, expected));
+
+    // another sequence whose first run merges into the last one
+    sequence other;
+    other.append(3, 2);
+    other.append(4, 1);
+    s.append(other);
+    append(expected, 3, 2);
+    append(expected, 4, 1);
+    CHECK(matches(s, expected));
+
+    // a different Check goes through for_each_chunk and merges the same way
+    repeat_n::rle_sequence<int, repeat_n::unchecked> unchecked;
+    unchecked.append(4, 2);
+    unchecked.append(5, 2);
+    s.append(unchecked);
+    append(expected, 4, 2);
+    append(expected, 5, 2);
+    CHECK(matches(s, expected));
+
+    CHECK(matches(sequence(s), expected));
+    CHECK(sequence(s) == s);
+    s.clear();
+    CHECK(matches(s, std::vector<int>()));
+}
+
+void check_self_append() {
+    // the first and last runs are equal, so the appended first run merges into the last
+    sequence s;
+    s.append(1, 2);
+    s.append(2, 1);
+    s.append(1, 3);
+    std::vector<int> expected = {1, 1, 2, 1, 1, 1};
+    s.append(s);
+    expected.insert(expected.end(), expected.begin(), expected.end());
+    CHECK(s.size() == 12);
+    CHECK(matches(s, expected));
+
+    // a single run doubles
+    sequence one;
+    one.append(7, 5);
+    one.append(one);
+    CHECK(one.size() == 10);
+    CHECK(one.runs() == 1);
+
+    sequence empty;
+    empty.append(empty);
+    CHECK(empty.empty());
+}
+} // namespace
+
+int main() {
+    check_append();
+    check_self_append();
+    return test::result();
+}
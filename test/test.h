@@ -0,0 +1,42 @@
+/*
+ * Copyright 2021 Chandradeep Dey
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef REPEAT_N_TEST_TEST_H
+#define REPEAT_N_TEST_TEST_H
+
+#include <cstdio>
+
+// Every test is a plain executable that CTest runs, which fails when main returns non-zero. CHECK reports each
+// failed condition and keeps going, test::result() is what main returns.
+namespace test {
+inline int &failures() {
+    static int count = 0;
+    return count;
+}
+
+inline void check(bool ok, const char *condition, const char *file, int line) {
+    if (!ok) {
+        std::fprintf(stderr, "%s:%d: CHECK(%s) failed\n", file, line, condition);
+        ++failures();
+    }
+}
+
+inline int result() { return failures() == 0 ? 0 : 1; }
+} // namespace test
+
+#define CHECK(condition) ::test::check(static_cast<bool>(condition), #condition, __FILE__, __LINE__)
+
+#endif // REPEAT_N_TEST_TEST_H